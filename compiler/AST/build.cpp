@@ -2124,11 +2124,17 @@ CallExpr* buildScanExpr(Expr* opExpr, Expr* dataExpr, bool zippered) {
   buildReduceScanPreface1(fn, data, eltType, opExpr, dataExpr, zippered);
   buildReduceScanPreface2(fn, eltType, globalOp, opExpr);
 
-  fn->insertAtTail("compilerWarning('scan has been serialized (see note in $CHPL_HOME/STATUS)')");
+  BlockStmt* serialWarning = new BlockStmt();
+  serialWarning->insertAtTail("compilerWarning('scan has been serialized (see note in $CHPL_HOME/STATUS)')");
 
   if( !zippered ) {
-    fn->insertAtTail("'return'(chpl__scanIterator(%S, %S))", globalOp, data);
+    // chpl__scan() only runs in parallel when chpl__scanSupportsPar() is
+    // true; that's a param, so this conditional is folded away.
+    fn->insertAtTail(new CondStmt(new CallExpr("!", new CallExpr("chpl__scanSupportsPar", globalOp, data)),
+                                  serialWarning));
+    fn->insertAtTail("'return'(chpl__scan(%S, %S))", globalOp, data);
   } else {
+    fn->insertAtTail(serialWarning);
     fn->insertAtTail("'return'(chpl__scanIteratorZip(%S, %S))", globalOp, data);
   }
 
@@ -44,6 +44,7 @@
 #include <cctype>
 #include <cstring>
 #include <cstdio>
+#include <unistd.h>
 #include <vector>
 
 // Global so that we don't have to pass around
@@ -52,6 +53,10 @@ GenInfo* gGenInfo   =  0;
 int      gMaxVMT    = -1;
 int      gStmtCount =  0;
 
+// With --incremental, the generated .c files (without the .c) that are
+// compiled separately rather than #included into _main.c
+static std::vector<const char*> splitFileNames;
+
 
 // ensure these two produce consistent output
 std::string zlineToString(BaseAST* ast) {
@@ -1717,26 +1722,25 @@ void codegen(void) {
     fprintf(mainfile.fptr, "#include \"%s.c\"\n", sCfgFname);
     fprintf(mainfile.fptr, "#include \"chpl__defn.c\"\n");
 
-    std::vector<const char*> userFileName;
     if(fIncrementalCompilation) {
       ChainHashMap<char*, StringHashFns, int> fileNameHashMap;
       forv_Vec(ModuleSymbol, currentModule, allModules) {
         const char* filename = NULL;
         filename = generateFileName(fileNameHashMap, filename, currentModule->name);
-        if(currentModule->modTag == MOD_USER) {
+        {
           fileinfo modulefile;
           openCFile(&modulefile, filename, "c");
           int modulePathLen = strlen(astr(modulefile.pathname));
           char path[FILENAME_MAX];
           strncpy(path, astr(modulefile.pathname), modulePathLen-2);
           path[modulePathLen-2]='\0';
-          userFileName.push_back(astr(path));
+          splitFileNames.push_back(astr(path));
           closeCFile(&modulefile);
         }
       }
     }
 
-    codegen_makefile(&mainfile, NULL, false, userFileName);
+    codegen_makefile(&mainfile, NULL, false, splitFileNames);
   }
 
   // Vectors to store different symbol names to be used while generating header
@@ -1790,12 +1794,12 @@ void codegen(void) {
       fileinfo modulefile;
       openCFile(&modulefile, filename, "c");
       info->cfile = modulefile.fptr;
-      if(fIncrementalCompilation && (currentModule->modTag == MOD_USER))
+      if(fIncrementalCompilation)
         fprintf(modulefile.fptr, "#include \"chpl__header.h\"\n");
       currentModule->codegenDef();
       closeCFile(&modulefile);
 
-      if(!(fIncrementalCompilation && (currentModule->modTag == MOD_USER)))
+      if(!fIncrementalCompilation)
         fprintf(mainfile.fptr, "#include \"%s%s\"\n", filename, ".c");
     }
 
@@ -1830,10 +1834,28 @@ void makeBinary(void) {
 #endif
   } else {
     const char* makeflags = printSystemCommands ? "-f " : "-s -f ";
+    const char* jobsflag  = "";
+
+    if (fIncrementalCompilation) {
+      int jobs = fIncrementalJobs;
+
+      if (jobs <= 0)
+        jobs = (int) sysconf(_SC_NPROCESSORS_ONLN);
+
+      if (jobs > 1)
+        jobsflag = astr("-j ", istr(jobs), " ");
+
+      restoreCachedObjects(splitFileNames);
+    }
+
     const char* command = astr(astr(CHPL_MAKE, " "),
+                               jobsflag,
                                makeflags,
                                getIntermediateDirName(), "/Makefile");
     mysystem(command, "compiling generated source");
+
+    if (fIncrementalCompilation)
+      saveCachedObjects(splitFileNames);
   }
 }
 
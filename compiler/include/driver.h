@@ -199,6 +199,9 @@ extern bool fMinimalModules;
 
 // Set to true if we want to enable incremental compilation.
 extern bool fIncrementalCompilation;
+// Number of generated C files to compile at once with --incremental;
+// 0 means one per processor.
+extern int fIncrementalJobs;
 
 // Set to true if we want to use the experimental
 // Interactive Programming Environment (IPE) mode.
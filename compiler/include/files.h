@@ -28,6 +28,9 @@
 
 extern char executableFilename[FILENAME_MAX+1];
 extern char saveCDir[FILENAME_MAX+1];
+extern char incrementalCacheDir[FILENAME_MAX+1];
+extern char compilerCacheDir[FILENAME_MAX+1];
+extern double compilerCacheSavedTime;
 extern std::string ccflags;
 extern std::string ldflags;
 extern bool ccwarnings;
@@ -43,6 +46,9 @@ struct fileinfo {
 
 void codegen_makefile(fileinfo* mainfile, const char** tmpbinname=NULL, bool skip_compile_link=false, const std::vector<const char *>& splitFiles = std::vector<const char*>());
 
+void restoreCachedObjects(const std::vector<const char*>& splitFiles);
+void saveCachedObjects(const std::vector<const char*>& splitFiles);
+
 void ensureDirExists(const char* /* dirname */, const char* /* explanation */);
 const char* getCwd();
 const char* makeTempDir(const char* dirPrefix);
@@ -79,6 +85,7 @@ const char* createDebuggerFile(const char* debugger, int argc, char* argv[]);
 std::string runPrintChplEnv(std::map<std::string, const char*> varMap);
 std::string getChplPythonVersion(void);
 std::string runCommand(std::string& command);
+std::string runCachedCommand(std::string& command);
 
 void setupModulePaths(void);
 void addFlagModulePath(const char* newpath);
@@ -21,6 +21,7 @@
 
 #include "baseAST.h"
 #include "driver.h"
+#include "files.h"
 
 #include <cstdlib>
 #include <cstring>
@@ -319,6 +320,12 @@ void Phase::ReportPass(unsigned long now) const
 
 void Phase::ReportTotal(unsigned long totalTime)
 {
+  if (compilerCacheSavedTime > 0.0)
+  {
+    ReportTime("saved by compiler cache", compilerCacheSavedTime);
+    ReportText("\n");
+  }
+
   ReportTime("total time", totalTime / 1e6);
   ReportText("\n\n\n\n");
 }
@@ -141,6 +141,7 @@ bool fNoRemoveEmptyRecords = true;
 bool fRemoveUnreachableBlocks = true;
 bool fMinimalModules = false;
 bool fIncrementalCompilation = false;
+int fIncrementalJobs = 0;
 bool fUseIPE         = false;
 
 int optimize_on_clause_limit = 20;
@@ -810,6 +811,9 @@ static ArgumentDescription arg_desc[] = {
  {"remove-unreachable-blocks", ' ', NULL, "[Don't] remove unreachable blocks after resolution", "N", &fRemoveUnreachableBlocks, "CHPL_REMOVE_UNREACHABLE_BLOCKS", NULL},
  {"replace-array-accesses-with-ref-temps", ' ', NULL, "Enable [disable] replacing array accesses with reference temps (experimental)", "N", &fReplaceArrayAccessesWithRefTemps, NULL, NULL },
  {"incremental", ' ', NULL, "Enable [disable] using incremental compilation", "N", &fIncrementalCompilation, "CHPL_INCREMENTAL_COMP", NULL},
+ {"incremental-jobs", ' ', "<jobs>", "Number of generated C files to compile at once with --incremental, 0 for one per processor", "I", &fIncrementalJobs, "CHPL_INCREMENTAL_JOBS", NULL},
+ {"incremental-cache", ' ', "<directory>", "Reuse object files compiled with --incremental from directory", "P", incrementalCacheDir, "CHPL_INCREMENTAL_CACHE_DIR", NULL},
+ {"compiler-cache", ' ', "<directory>", "Reuse the configuration computed by earlier compilations from directory", "P", compilerCacheDir, "CHPL_COMPILER_CACHE_DIR", NULL},
  {"minimal-modules", ' ', NULL, "Enable [disable] using minimal modules",               "N", &fMinimalModules, "CHPL_MINIMAL_MODULES", NULL},
  DRIVER_ARG_PRINT_CHPL_HOME,
  DRIVER_ARG_LAST
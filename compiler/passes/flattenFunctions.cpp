@@ -26,6 +26,8 @@
 #include "stmt.h"
 #include "stlUtil.h"
 
+#include <algorithm>
+
 static void flattenNestedFunctions(Vec<FnSymbol*>& nestedFunctions);
 
 void flattenFunctions() {
@@ -173,10 +175,33 @@ passByRef(Symbol* sym) {
 }
 
 
+static bool
+symbolIdLess(Symbol* a, Symbol* b) {
+  return a->id < b->id;
+}
+
+//
+// returns the symbols in vars ordered by AST id, so that the formals and
+// actuals added for them don't depend on where the symbols happened to
+// be allocated, and the generated code is the same from run to run
+//
+static std::vector<Symbol*>
+sortedVars(SymbolMap* vars) {
+  std::vector<Symbol*> syms;
+  form_Map(SymbolMapElem, e, *vars) {
+    if (e->key)
+      syms.push_back(e->key);
+  }
+  std::sort(syms.begin(), syms.end(), symbolIdLess);
+  return syms;
+}
+
+
 static void
 addVarsToFormals(FnSymbol* fn, SymbolMap* vars) {
-  form_Map(SymbolMapElem, e, *vars) {
-    if (Symbol* sym = e->key) {
+  std::vector<Symbol*> syms = sortedVars(vars);
+  for (size_t i = 0; i < syms.size(); i++) {
+    if (Symbol* sym = syms[i]) {
       Type* type = sym->type;
       IntentTag intent = INTENT_BLANK;
 
@@ -244,9 +269,10 @@ replaceVarUsesWithFormals(FnSymbol* fn, SymbolMap* vars) {
   if (vars->n == 0) return;
   std::vector<SymExpr*> symExprs;
   collectSymExprs(fn->body, symExprs);
-  form_Map(SymbolMapElem, e, *vars) {
-    if (Symbol* sym = e->key) {
-      ArgSymbol* arg = toArgSymbol(e->value);
+  std::vector<Symbol*> syms = sortedVars(vars);
+  for (size_t i = 0; i < syms.size(); i++) {
+    if (Symbol* sym = syms[i]) {
+      ArgSymbol* arg = toArgSymbol(vars->get(sym));
       Type* type = arg->type;
       for_vector(SymExpr, se, symExprs) {
           if (se->symbol() == sym) {
@@ -303,8 +329,9 @@ replaceVarUsesWithFormals(FnSymbol* fn, SymbolMap* vars) {
 
 static void
 addVarsToActuals(CallExpr* call, SymbolMap* vars, bool outerCall) {
-  form_Map(SymbolMapElem, e, *vars) {
-    if (Symbol* sym = e->key) {
+  std::vector<Symbol*> syms = sortedVars(vars);
+  for (size_t i = 0; i < syms.size(); i++) {
+    if (Symbol* sym = syms[i]) {
       SET_LINENO(sym);
       if (!outerCall && passByRef(sym)) {
         // This is only a performance issue.
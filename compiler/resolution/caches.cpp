@@ -23,8 +23,25 @@
 #include "stringutil.h"
 
 
+//
+// Pairs with a NULL value are skipped, since isCacheEntryMatch treats
+// them the same as missing pairs.
+//
+static uintptr_t
+hashSymbolMap(SymbolMap* map) {
+  uintptr_t hash = 0;
+  form_Map(SymbolMapElem, e, *map) {
+    if (e->key && e->value) {
+      uintptr_t pair = (uintptr_t)e->key * 31 + (uintptr_t)e->value;
+      hash += pair ^ (pair >> 7);
+    }
+  }
+  return hash;
+}
+
+
 SymbolMapCacheEntry::SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap) :
-  fn(ifn), map(*imap) { }
+  fn(ifn), map(*imap), hash(hashSymbolMap(imap)) { }
 
 
 void
@@ -56,8 +73,9 @@ isCacheEntryMatch(SymbolMap* s1, SymbolMap* s2) {
 FnSymbol*
 checkCache(SymbolMapCache& cache, FnSymbol* oldFn, SymbolMap* map) {
   if (Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn)) {
+    uintptr_t hash = hashSymbolMap(map);
     forv_Vec(SymbolMapCacheEntry, entry, *entries) {
-      if (isCacheEntryMatch(map, &entry->map))
+      if (entry->hash == hash && isCacheEntryMatch(map, &entry->map))
         return entry->fn;
     }
   }
@@ -68,8 +86,9 @@ checkCache(SymbolMapCache& cache, FnSymbol* oldFn, SymbolMap* map) {
 void
 replaceCache(SymbolMapCache& cache, FnSymbol* oldFn, FnSymbol* fn, SymbolMap* map) {
   if (Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn)) {
+    uintptr_t hash = hashSymbolMap(map);
     forv_Vec(SymbolMapCacheEntry, entry, *entries) {
-      if (isCacheEntryMatch(map, &entry->map)) {
+      if (entry->hash == hash && isCacheEntryMatch(map, &entry->map)) {
         entry->fn = fn;
         return;
       }
@@ -35,11 +35,16 @@
 //
 //   freeCache(cache): frees memory associated with cache
 //
+//   Each entry also records a hash of its map that doesn't depend on
+//   the order of the key-value pairs, so that most non-matching entries
+//   can be skipped without comparing the maps.
+//
 class SymbolMapCacheEntry {
  public:
   SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap);
   FnSymbol* fn;
   SymbolMap map;
+  uintptr_t hash;
 };
 typedef Map<FnSymbol*,Vec<SymbolMapCacheEntry*>*> SymbolMapCache;
 typedef MapElem<FnSymbol*,Vec<SymbolMapCacheEntry*>*> SymbolMapCacheElem;
@@ -48,6 +48,7 @@
 #include "../ifa/prim_data.h"
 #include "view.h"
 
+#include <algorithm>
 #include <inttypes.h>
 #include <map>
 #include <sstream>
@@ -2285,6 +2286,20 @@ expandVarArgs(FnSymbol* origFn, int numActuals) {
 
   static Map<FnSymbol*,Vec<FnSymbol*>*> cache;
 
+  // Most functions don't take a variable number of arguments, and there
+  // is nothing to expand or to cache for them.
+  bool hasVarArgs = false;
+
+  for_formals(formal, origFn) {
+    if (formal->variableExpr) {
+      hasVarArgs = true;
+      break;
+    }
+  }
+
+  if (!hasVarArgs)
+    return origFn;
+
   // check for cached stamped out function
   if (Vec<FnSymbol*>* cfns = cache.get(origFn)) {
     forv_Vec(FnSymbol, cfn, *cfns) {
@@ -4137,12 +4152,63 @@ resolveDefaultGenericType(CallExpr* call) {
 }
 
 
+//
+// Whether filterCandidate accepts a function depends only on the function
+// and on the call's signature: the number, names and types of the actuals,
+// whether each is a type, and the value of each param actual.  So once a
+// function has been rejected for a signature, later calls with the same
+// signature -- which is most calls to '=', '+', chpl__autoCopy and the
+// like -- can skip it.  'rejectedCandidates' holds, for each signature
+// seen so far, the set of functions that have been rejected for it.
+// Rejections made while resolving the body of a tryToken conditional may
+// be due to errors that were suppressed there, so they aren't recorded.
+//
+typedef std::vector<void*> CallSignature;
+
+static std::map<CallSignature, Vec<FnSymbol*>*> rejectedCandidates;
+
+static Vec<FnSymbol*>*
+getRejectedCandidates(CallInfo& info) {
+  CallSignature sig;
+
+  for (int i = 0; i < info.actuals.n; i++) {
+    Symbol* actual = info.actuals.v[i];
+
+    sig.push_back((void*)info.actualNames.v[i]);
+    sig.push_back((void*)actual->type);
+    sig.push_back(actual->hasFlag(FLAG_TYPE_VARIABLE) ? (void*)gTrue : NULL);
+    sig.push_back(actual->isParameter() ? (void*)actual : NULL);
+  }
+
+  Vec<FnSymbol*>*& rejected = rejectedCandidates[sig];
+
+  if (rejected == NULL)
+    rejected = new Vec<FnSymbol*>();
+
+  return rejected;
+}
+
+static void
+freeRejectedCandidates() {
+  for (std::map<CallSignature, Vec<FnSymbol*>*>::iterator it =
+         rejectedCandidates.begin();
+       it != rejectedCandidates.end();
+       ++it) {
+    delete it->second;
+  }
+
+  rejectedCandidates.clear();
+}
+
+
 static void
 doGatherCandidates(Vec<ResolutionCandidate*>& candidates,
                  Vec<FnSymbol*>& visibleFns,
                  CallInfo& info,
                  bool compilerGenerated) {
 
+  Vec<FnSymbol*>* rejected = getRejectedCandidates(info);
+
   forv_Vec(FnSymbol, visibleFn, visibleFns) {
     // Only consider user functions or compiler-generated functions
     if (visibleFn->hasFlag(FLAG_COMPILER_GENERATED) == compilerGenerated) {
@@ -4170,7 +4236,15 @@ doGatherCandidates(Vec<ResolutionCandidate*>& candidates,
         }
       }
 
+      if (rejected->set_in(visibleFn))
+        continue;
+
+      int numCandidates = candidates.n;
+
       filterCandidate(candidates, visibleFn, info);
+
+      if (candidates.n == numCandidates && tryStack.n == 0)
+        rejected->set_add(visibleFn);
     }
   }
 }
@@ -8945,6 +9019,7 @@ resolve() {
   }
   visibleFunctionMap.clear();
   visibilityBlockCache.clear();
+  freeRejectedCandidates();
   clearPartialCopyFnMap();
 
   forv_Vec(BlockStmt, stmt, gBlockStmts) {
@@ -9085,6 +9160,10 @@ static void filterVirtualChildren()
   }
 }
 
+static bool fnIdLess(FnSymbol* a, FnSymbol* b) {
+  return a->id < b->id;
+}
+
 static void resolveDynamicDispatches() {
   inDynamicDispatchResolution = true;
   int num_types;
@@ -9109,14 +9188,21 @@ static void resolveDynamicDispatches() {
     buildVirtualMaps();
   } while (num_types != gTypeSymbols.n);
 
+  // Add the roots in AST id order rather than in the (address-based)
+  // order of virtualRootsMap, so that the virtual method table, and the
+  // generated code, are the same from run to run.
+  std::vector<FnSymbol*> roots;
   for (int i = 0; i < virtualRootsMap.n; i++) {
     if (virtualRootsMap.v[i].key) {
       for (int j = 0; j < virtualRootsMap.v[i].value->n; j++) {
-        FnSymbol* root = virtualRootsMap.v[i].value->v[j];
-        addVirtualMethodTableEntry(root->_this->type, root, true);
+        roots.push_back(virtualRootsMap.v[i].value->v[j]);
       }
     }
   }
+  std::sort(roots.begin(), roots.end(), fnIdLess);
+  for_vector(FnSymbol, root, roots) {
+    addVirtualMethodTableEntry(root->_this->type, root, true);
+  }
 
   Vec<Type*> ctq;
   ctq.add(dtObject);
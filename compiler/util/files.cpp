@@ -35,10 +35,14 @@
 #include "mysystem.h"
 #include "stringutil.h"
 #include "tmpdirname.h"
+#include "timer.h"
+#include "version.h"
 
+#include <dirent.h>
 #include <pwd.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 #include <cerrno>
@@ -50,6 +54,10 @@
 
 char               executableFilename[FILENAME_MAX + 1] = "a.out";
 char               saveCDir[FILENAME_MAX + 1]           = "";
+char               incrementalCacheDir[FILENAME_MAX + 1] = "";
+char               compilerCacheDir[FILENAME_MAX + 1]   = "";
+
+double             compilerCacheSavedTime               = 0.0;
 
 std::string ccflags;
 std::string ldflags;
@@ -454,7 +462,7 @@ std::string runPrintChplEnv(std::map<std::string, const char*> varMap) {
   // Toss stderr away until printchplenv supports a '--suppresswarnings' flag
   command += std::string(CHPL_HOME) + "/util/printchplenv --simple 2> /dev/null";
 
-  return runCommand(command);
+  return runCachedCommand(command);
 }
 
 std::string getChplPythonVersion() {
@@ -592,6 +600,29 @@ void codegen_makefile(fileinfo* mainfile, const char** tmpbinname, bool skip_com
 
   fprintf(makefile.fptr, "\nCHPL_MAKE_ALL_VARS = %s\n", chplmakeallvars.c_str());
 
+  // Makefile.base only runs printchplenv itself if this isn't set.
+  if (compilerCacheDir[0] != '\0') {
+    std::string command  = chplmakeallvars;
+    std::string settings = "";
+
+    command += std::string(CHPL_HOME) + "/util/printchplenv --make";
+
+    std::string output = runCachedCommand(command);
+
+    for (size_t i = 0; i < output.length(); i++) {
+      switch (output[i]) {
+        case '\n': settings += "|";   break;
+        case '$':  settings += "$$";  break;
+        case '#':  settings += "\\#"; break;
+        default:   settings += output[i];
+      }
+    }
+
+    fprintf(makefile.fptr,
+            "export CHPL_MAKE_SETTINGS_NO_NEWLINES = %s\n",
+            settings.c_str());
+  }
+
 
   // LLVM builds just use the makefile for the launcher and
   // so want to skip the actual program generation.
@@ -692,6 +723,308 @@ void codegen_makefile(fileinfo* mainfile, const char** tmpbinname, bool skip_com
 }
 
 
+//
+// With --incremental-cache, the object file for each separately compiled
+// module is saved in the cache directory, named by a hash of everything
+// that went into compiling it: its .c file, the shared header, and the
+// compiler version, configuration and flags.  When the same hash comes up
+// again the saved object is copied into place, and since it is then newer
+// than the .c file, make doesn't recompile it.
+//
+
+static void hashBytes(uint64_t& hash, const char* bytes, size_t len) {
+  // 64-bit FNV-1a
+  for (size_t i = 0; i < len; i++) {
+    hash ^= (unsigned char)bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+static void hashString(uint64_t& hash, const std::string& str) {
+  hashBytes(hash, str.c_str(), str.length() + 1);
+}
+
+static bool hashFile(uint64_t& hash, const char* pathname) {
+  FILE* fp = fopen(pathname, "rb");
+  if (fp == NULL)
+    return false;
+
+  char   buf[64 * 1024];
+  size_t len;
+  while ((len = fread(buf, 1, sizeof(buf), fp)) > 0)
+    hashBytes(hash, buf, len);
+
+  fclose(fp);
+  return true;
+}
+
+// Hash everything but the module's own .c file.
+static uint64_t hashCompileConfig() {
+  uint64_t hash = 14695981039346656037ULL;
+  char     version[128];
+  char     opts[128];
+
+  get_version(version);
+  hashString(hash, version);
+  hashString(hash, CHPL_HOME);
+
+  for (std::map<std::string, const char*>::iterator env = envMap.begin();
+       env != envMap.end();
+       ++env) {
+    hashString(hash, env->first);
+    hashString(hash, env->second ? env->second : "");
+  }
+
+  snprintf(opts, sizeof(opts), "%d %d %d %d %d %d %d",
+           ccwarnings, debugCCode, optimizeCCode, specializeCCode,
+           ffloatOpt, fLibraryCompile, fLinkStyle);
+  hashString(hash, opts);
+  hashString(hash, ccflags);
+
+  forv_Vec(const char*, dirName, incDirs) {
+    hashString(hash, dirName);
+  }
+
+  hashFile(hash, genIntermediateFilename("chpl__header.h"));
+
+  return hash;
+}
+
+static const char* cachedObjectName(uint64_t configHash, const char* cfile) {
+  uint64_t hash = configHash;
+  char     name[32];
+
+  if (!hashFile(hash, cfile))
+    return NULL;
+
+  snprintf(name, sizeof(name), "%016llx.o", (unsigned long long)hash);
+
+  return astr(incrementalCacheDir, "/", name);
+}
+
+static bool copyFile(const char* from, const char* to) {
+  FILE* in  = fopen(from, "rb");
+  FILE* out = NULL;
+  bool  ok  = false;
+
+  if (in != NULL && (out = fopen(to, "wb")) != NULL) {
+    char   buf[64 * 1024];
+    size_t len;
+
+    ok = true;
+    while (ok && (len = fread(buf, 1, sizeof(buf), in)) > 0)
+      ok = (fwrite(buf, 1, len, out) == len);
+
+    ok = ok && !ferror(in);
+  }
+
+  if (out != NULL && fclose(out) != 0)
+    ok = false;
+
+  if (in != NULL)
+    fclose(in);
+
+  return ok;
+}
+
+// Copy the cached object for each module that has one into place.
+void restoreCachedObjects(const std::vector<const char*>& splitFiles) {
+  if (incrementalCacheDir[0] == '\0' || splitFiles.size() == 0)
+    return;
+
+  uint64_t configHash = hashCompileConfig();
+
+  for (size_t i = 0; i < splitFiles.size(); i++) {
+    const char* cached = cachedObjectName(configHash,
+                                          astr(splitFiles[i], ".c"));
+    const char* object = astr(splitFiles[i], ".o");
+
+    if (cached != NULL && copyFile(cached, object)) {
+      if (printSystemCommands)
+        printf("# reusing %s for %s\n", cached, object);
+    } else {
+      unlink(object);
+    }
+  }
+}
+
+// Add each module's object to the cache, if it isn't already there.
+void saveCachedObjects(const std::vector<const char*>& splitFiles) {
+  if (incrementalCacheDir[0] == '\0' || splitFiles.size() == 0)
+    return;
+
+  ensureDirExists(incrementalCacheDir, "creating incremental cache directory");
+
+  uint64_t configHash = hashCompileConfig();
+
+  for (size_t i = 0; i < splitFiles.size(); i++) {
+    const char* cached = cachedObjectName(configHash,
+                                          astr(splitFiles[i], ".c"));
+    struct stat statBuf;
+
+    if (cached == NULL || stat(cached, &statBuf) == 0)
+      continue;
+
+    // Copy to a temporary name first so that a concurrent compile
+    // never sees a partial object.
+    char pidstr[MAX_CHARS_PER_PID];
+    snprintf(pidstr, MAX_CHARS_PER_PID, ".%d", (int)getpid());
+    const char* tmpName = astr(cached, pidstr);
+
+    if (copyFile(astr(splitFiles[i], ".o"), tmpName) == false ||
+        rename(tmpName, cached) != 0) {
+      unlink(tmpName);
+    }
+  }
+}
+
+
+//
+// With --compiler-cache, the output of the printchplenv runs that every
+// compilation makes (one to configure the compiler and, when generating
+// code, several more from make) is saved in the cache directory and
+// reused by later compilations.  printchplenv bases some of its defaults
+// on what has been built in third-party, so the output is keyed on the
+// installed third-party packages as well as on the command, which holds
+// the settings passed in by the compiler, and the CHPL_ environment.
+//
+
+extern char** environ;
+
+static uint64_t hashChplEnvConfig(const std::string& command) {
+  uint64_t                 hash = 14695981039346656037ULL;
+  char                     version[128];
+  std::vector<std::string> vars;
+
+  get_version(version);
+  hashString(hash, version);
+  hashString(hash, CHPL_HOME);
+  hashString(hash, command);
+
+  for (char** env = environ; *env != NULL; env++) {
+    if (strncmp(*env, "CHPL_", 5) == 0)
+      vars.push_back(*env);
+  }
+
+  std::sort(vars.begin(), vars.end());
+
+  for (size_t i = 0; i < vars.size(); i++)
+    hashString(hash, vars[i]);
+
+  // Each package is (re)built into third-party/<package>/install/<config>
+  const char* thirdParty = astr(CHPL_HOME, "/third-party");
+
+  if (DIR* dir = opendir(thirdParty)) {
+    std::vector<std::string> installs;
+
+    while (struct dirent* dp = readdir(dir)) {
+      const char* install = astr(thirdParty, "/", dp->d_name, "/install");
+
+      if (DIR* idir = opendir(install)) {
+        installs.push_back(install);
+
+        while (struct dirent* idp = readdir(idir)) {
+          if (idp->d_name[0] != '.')
+            installs.push_back(astr(install, "/", idp->d_name));
+        }
+
+        closedir(idir);
+      }
+    }
+
+    closedir(dir);
+
+    std::sort(installs.begin(), installs.end());
+
+    for (size_t i = 0; i < installs.size(); i++) {
+      struct stat statBuf;
+
+      if (stat(installs[i].c_str(), &statBuf) == 0) {
+        hashString(hash, installs[i]);
+        hashBytes(hash, (const char*) &statBuf.st_mtime,
+                  sizeof(statBuf.st_mtime));
+      }
+    }
+  }
+
+  return hash;
+}
+
+// The first line of a cache entry holds the time, in microseconds, that
+// the command took to run; the rest is its output.
+static bool readCachedCommand(const char* cached, std::string& output) {
+  FILE*         fp   = fopen(cached, "rb");
+  unsigned long usec = 0;
+
+  if (fp == NULL)
+    return false;
+
+  if (fscanf(fp, "%lu\n", &usec) != 1) {
+    fclose(fp);
+    return false;
+  }
+
+  char   buf[4096];
+  size_t len;
+
+  output = "";
+  while ((len = fread(buf, 1, sizeof(buf), fp)) > 0)
+    output.append(buf, len);
+
+  fclose(fp);
+
+  compilerCacheSavedTime += usec / 1e6;
+
+  return true;
+}
+
+static void writeCachedCommand(const char*        cached,
+                               unsigned long      usec,
+                               const std::string& output) {
+  char pidstr[MAX_CHARS_PER_PID];
+
+  snprintf(pidstr, MAX_CHARS_PER_PID, ".%d", (int)getpid());
+
+  const char* tmpName = astr(cached, pidstr);
+  FILE*       fp      = fopen(tmpName, "wb");
+
+  if (fp == NULL)
+    return;
+
+  bool ok = fprintf(fp, "%lu\n", usec) > 0 &&
+            fwrite(output.c_str(), 1, output.length(), fp) == output.length();
+
+  if (fclose(fp) != 0 || ok == false || rename(tmpName, cached) != 0)
+    unlink(tmpName);
+}
+
+std::string runCachedCommand(std::string& command) {
+  if (compilerCacheDir[0] == '\0')
+    return runCommand(command);
+
+  char name[32];
+
+  snprintf(name, sizeof(name), "chplenv-%016llx",
+           (unsigned long long)hashChplEnvConfig(command));
+
+  const char* cached = astr(compilerCacheDir, "/", name);
+  std::string output;
+
+  if (readCachedCommand(cached, output) == false) {
+    Timer timer;
+
+    timer.start();
+    output = runCommand(command);
+    timer.stop();
+
+    ensureDirExists(compilerCacheDir, "creating compiler cache directory");
+    writeCachedCommand(cached, timer.elapsedUsecs(), output);
+  }
+
+  return output;
+}
+
+
 static const char* searchPath(Vec<const char*> path, const char* filename,
                               const char* foundfile = NULL,
                               bool noWarn = false) {
@@ -946,6 +946,89 @@ proc BlockCyclicArr.dsiSlice(d: BlockCyclicDom) {
   return alias;
 }
 
+proc BlockCyclicArr.dsiSupportsBulkTransferInterface() param return true;
+
+proc BlockCyclicArr.doiCanBulkTransferStride() param {
+  if debugBlockCyclicDist then
+    writeln("In BlockCyclicArr.doiCanBulkTransferStride");
+
+  return useBulkTransferDist;
+}
+
+// With multi-ddata the local blocks may span ddata chunks.
+proc BlockCyclicArr.oneDData return defRectSimpleDData;
+
+proc BlockCyclicArr.doiUseBulkTransferStride(B) {
+  if debugBlockCyclicDist then
+    writeln("In BlockCyclicArr.doiUseBulkTransferStride()");
+
+  // Arrays over the same domain have their elements aligned, so the
+  // default zippered assignment copies them without communication.
+  if B._value.type == this.type then
+    if B._value.dom == dom then return false;
+
+  return oneDData && B._value.oneDData;
+}
+
+//
+// Strided bulk transfer: every block a locale owns is a separate
+// piece, stored in row-major order within the locale's flat myElems.
+// See bulkCommTransfer() in DefaultRectangular.
+//
+proc BlockCyclicArr.doiBulkTransferPieceLocDom() return dom.dist.targetLocDom;
+proc BlockCyclicArr.doiBulkTransferPieceLocale(i) return dom.dist.targetLocales(i);
+proc BlockCyclicArr.doiBulkTransferNumPieces(i)
+  return dom.locDoms(i).myStarts.numIndices;
+
+iter BlockCyclicArr.doiBulkTransferPieces(i) {
+  const myLocArr = locArr(i);
+  const flatArr = myLocArr.myElems._value;
+  const blocksize = dom.dist.blocksize;
+  const wholeDims = dom.whole.dims();
+
+  for start in myLocArr.indexDom.myStarts {
+    const s = chpl__tuplify(start);
+    var p: bulkCommPiece(rank, idxType, eltType);
+    var lo: rank*idxType;
+    var empty = false;
+    for param j in 1..rank {
+      p.region(j) = wholeDims(j)[s(j)..s(j)+blocksize(j)-1];
+      lo(j) = p.region(j).first;
+      if p.region(j).length == 0 then empty = true;
+    }
+    if empty then continue;
+
+    proc flatInd(ind) return if rank == 1 then myLocArr.mdInd2FlatInd(ind(1))
+                                          else myLocArr.mdInd2FlatInd(ind);
+    const base = flatInd(lo);
+    p.data = flatArr.dataChunk(0);
+    p.first = flatArr.getDataIndex(base, getShifted=false,
+                                   getChunked=false): int;
+    for param j in 1..rank {
+      var next = lo;
+      next(j) += p.region(j).stride: idxType;
+      p.stride(j) = flatInd(next) - base;
+    }
+    yield p;
+  }
+}
+
+//For assignments of the form: "BlockCyclic = any"
+//where "any" means any array that implements the bulk transfer interface
+proc BlockCyclicArr.doiBulkTransferFrom(Barg) {
+  bulkCommTransfer(this, Barg._value);
+}
+
+//For assignments of the form: DR = BlockCyclic
+proc BlockCyclicArr.doiBulkTransferToDR(Barg) {
+  bulkCommTransfer(Barg._value, this);
+}
+
+//For assignments of the form: BlockCyclic = DR
+proc BlockCyclicArr.doiBulkTransferFromDR(Barg) {
+  bulkCommTransfer(this, Barg._value);
+}
+
 proc BlockCyclicArr.dsiReindex(dom) {
   compilerError("reindexing not yet implemented for Block-Cyclic");
 }
@@ -200,8 +200,34 @@ config param disableStencilLazyRAD = defaultDisableLazyRADOpt;
 
     // ghost caches are now up-to-date
 
-  After updating, any read from the array should be up-to-date. The
-  ``updateFluff`` function does not currently accept any arguments.
+  After updating, any read from the array should be up-to-date.
+
+  Stencils that only read along the axes, such as the 5-point stencil,
+  do not need the cached elements at the corners.  Passing
+  ``corners=false`` to ``updateFluff`` leaves those elements out of the
+  update.  They are then out of date until a later update that includes
+  them.
+
+  The update can also be split into two phases so that it overlaps with
+  computation that does not read the cached elements:
+
+  .. code-block:: chapel
+
+    const h = A.beginUpdateFluff(corners=false);
+
+    // compute on elements whose neighbors are all owned by this locale
+
+    A.waitFluff(h);
+
+    // ghost caches are now up-to-date
+
+  ``beginUpdateFluff`` starts non-blocking GETs of each locale's cached
+  elements and returns a handle; ``waitFluff`` waits for them to complete.
+  Until then, the program must not write to the elements being copied
+  nor read the cached elements.  Each call to ``beginUpdateFluff`` must
+  be matched by a call to ``waitFluff`` before the next one.  For element
+  types that cannot be copied as raw bytes, ``beginUpdateFluff`` completes
+  the update before returning.
 
   **Reading and Writing to Array Elements**
 
@@ -346,6 +372,12 @@ class LocStencilArr {
   var locRADLock: atomicbool; // This will only be accessed locally
                               // force the use of processor atomics
 
+  // Runs of fluff to GET for beginUpdateFluff(), and their handles
+  var fluffRunDom: domain(1);
+  var fluffRuns: [fluffRunDom] stencilFluffRun;
+  var fluffHandles: [fluffRunDom] c_void_ptr;
+  var fluffRunsValid, fluffPending: bool;
+
   // These functions will always be called on this.locale, and so we do
   // not have an on statement around the while loop below (to avoid
   // the repeated on's from calling testAndSet()).
@@ -358,6 +390,17 @@ class LocStencilArr {
   }
 }
 
+//
+// A contiguous run of fluff and the remote elements it is copied from
+//
+record stencilFluffRun {
+  var dst: c_void_ptr;
+  var node: chpl_nodeID_t;
+  var src: c_void_ptr;
+  var size: size_t;
+  var corner: bool;     // part of an edge or corner neighbor's fluff
+}
+
 private proc makeZero(param rank : int) {
   var ret : rank*int;
   return ret;
@@ -690,10 +733,10 @@ proc StencilDom.getLocDom(localeIdx) return locDoms(localeIdx);
 //
 // Given a tuple of scalars of type t or range(t) match the shape but
 // using types rangeType and scalarType e.g. the call:
-// _matchArgsShape(range(int(32)), int(32), (1:int(64), 1:int(64)..5, 1:int(64)..5))
+// _stencil_matchArgsShape(range(int(32)), int(32), (1:int(64), 1:int(64)..5, 1:int(64)..5))
 // returns the type: (int(32), range(int(32)), range(int(32)))
 //
-proc _matchArgsShape(type rangeType, type scalarType, args) type {
+proc _stencil_matchArgsShape(type rangeType, type scalarType, args) type {
   proc helper(param i: int) type {
     if i == args.size {
       if isCollapsedDimension(args(i)) then
@@ -733,8 +776,8 @@ proc Stencil.dsiCreateRankChangeDist(param newRank: int, args) {
     }
   }
   const collapsedLocInd = targetLocsIdx(collapsedDimLocs);
-  var collapsedBbox: _matchArgsShape(range(idxType=idxType), idxType, args);
-  var collapsedLocs: _matchArgsShape(range(idxType=int), int, args);
+  var collapsedBbox: _stencil_matchArgsShape(range(idxType=idxType), idxType, args);
+  var collapsedLocs: _stencil_matchArgsShape(range(idxType=int), int, args);
 
   for param i in 1..rank {
     if isCollapsedDimension(args(i)) {
@@ -1380,7 +1423,7 @@ proc StencilArr.dsiRankChange(d, param newRank: int, param stridable: bool, args
       const locDom = d.getLocDom(ind);
       // locSlice is a tuple of ranges and scalars. It will match the basic
       // shape of the args argument. 
-      var locSlice: _matchArgsShape(range(idxType=idxType, stridable=stridable), idxType, args);
+      var locSlice: _stencil_matchArgsShape(range(idxType=idxType, stridable=stridable), idxType, args);
       // collapsedDims stores the value any collapsed dimension is down to.
       // For any non-collapsed dimension, that position is ignored.
       // This tuple is then passed to the targetLocsIdx function to build up a
@@ -1567,19 +1610,41 @@ proc StencilArr.dsiNoFluffView() {
 }
 
 // wrapper
-proc _array.updateFluff() {
-  _value.dsiUpdateFluff();
+proc _array.updateFluff(corners = true) {
+  _value.dsiUpdateFluff(corners);
+}
+
+// wrapper
+proc _array.beginUpdateFluff(corners = true) {
+  return _value.dsiBeginUpdateFluff(corners);
+}
+
+// wrapper
+proc _array.waitFluff(h: StencilFluffHandle) {
+  _value.dsiWaitFluff(h);
+}
+
+// Whether neighbor direction L is an edge or corner rather than a face.
+private inline proc isCornerNeighbor(L) {
+  var nonzero = 0;
+  for l in chpl__tuplify(L) do
+    if l != 0 then nonzero += 1;
+  return nonzero > 1;
 }
 
 // copy over into cache
-proc StencilArr.dsiUpdateFluff() {
+proc StencilArr.dsiUpdateFluff(corners = true) {
   if zeroTuple(dom.fluff) then return;
+  if chpl__supportedDataTypeForBulkTransfer(eltType) {
+    dsiWaitFluff(dsiBeginUpdateFluff(corners));
+    return;
+  }
   coforall i in dom.dist.targetLocDom {
     on dom.dist.targetLocales(i) {
       ref myLocDom = locArr[i].locDom;
       forall (S, D, N, L) in zip(myLocDom.Src, myLocDom.Dest,
           myLocDom.Neighs, myLocDom.NeighDom) {
-        if !zeroTuple(L) {
+        if !zeroTuple(L) && (corners || !isCornerNeighbor(L)) {
           if !dom.dist.targetLocDom.member(i+L) && dom.periodic then
             locArr[i].myElems[D] = locArr[N].myElems[S];
           else if dom.dist.targetLocDom.member(N) then
@@ -1590,6 +1655,147 @@ proc StencilArr.dsiUpdateFluff() {
   }
 }
 
+/*
+  A fluff update in progress, returned by ``beginUpdateFluff``.
+*/
+record StencilFluffHandle {
+  pragma "no doc"
+  var arr: BaseArr;
+}
+
+private extern proc sizeof(type x): size_t;
+pragma "insert line file info"
+private extern proc chpl_comm_get_nb(addr: c_void_ptr, node: chpl_nodeID_t,
+                                     raddr: c_void_ptr, size: size_t,
+                                     typeIndex: int(32)): c_void_ptr;
+private extern proc chpl_comm_wait_nb_some(h: c_ptr(c_void_ptr),
+                                           nhandles: size_t);
+
+//
+// Start copying each locale's fluff from the neighboring locales.  Each
+// locale GETs its own fluff, one non-blocking GET per contiguous run,
+// using the runs computed by setupFluffRuns().  Element types that
+// cannot be copied as raw bytes are updated before this returns.
+//
+proc StencilArr.dsiBeginUpdateFluff(corners = true) {
+  const h = new StencilFluffHandle(this);
+  if zeroTuple(dom.fluff) then return h;
+  if !chpl__supportedDataTypeForBulkTransfer(eltType) {
+    dsiUpdateFluff(corners);
+    return h;
+  }
+
+  const thisPid = pid;
+  coforall i in dom.dist.targetLocDom {
+    on dom.dist.targetLocales(i) {
+      const privArr = chpl_getPrivatizedCopy(this.type, thisPid);
+      const myLocArr = privArr.locArr[i];
+      if myLocArr.fluffPending then
+        halt("beginUpdateFluff() called again before waitFluff()");
+      if !myLocArr.fluffRunsValid then
+        privArr.setupFluffRuns(i);
+      myLocArr.fluffPending = true;
+      for (r, handle) in zip(myLocArr.fluffRuns, myLocArr.fluffHandles) {
+        if corners || !r.corner then
+          handle = chpl_comm_get_nb(r.dst, r.node, r.src, r.size, -1);
+        else
+          handle = c_nil;
+      }
+    }
+  }
+  return h;
+}
+
+//
+// Wait for the GETs started by dsiBeginUpdateFluff() to complete.
+//
+proc StencilArr.dsiWaitFluff(h: StencilFluffHandle) {
+  if h.arr != this then
+    halt("waitFluff() called with a handle from a different array");
+  if zeroTuple(dom.fluff) || !chpl__supportedDataTypeForBulkTransfer(eltType)
+    then return;
+
+  const thisPid = pid;
+  coforall i in dom.dist.targetLocDom {
+    on dom.dist.targetLocales(i) {
+      const privArr = chpl_getPrivatizedCopy(this.type, thisPid);
+      const myLocArr = privArr.locArr[i];
+      if !myLocArr.fluffPending then
+        halt("waitFluff() called without a pending beginUpdateFluff()");
+      const n = myLocArr.fluffRunDom.size;
+      if n > 0 then
+        chpl_comm_wait_nb_some(c_ptrTo(myLocArr.fluffHandles[0]),
+                               n: size_t);
+      myLocArr.fluffPending = false;
+    }
+  }
+}
+
+//
+// Compute the contiguous runs of locale i's fluff and where each is
+// copied from: the same indices in the neighbor's elements or, across
+// a periodic boundary, the wrapped-around indices.  Called on locale i.
+//
+proc StencilArr.setupFluffRuns(i) {
+  const myLocArr = locArr[i];
+  const myLocDom = myLocArr.locDom;
+
+  // Whether neighbor L's fluff is copied, and whether across the boundary
+  proc fluffSource(N, L) {
+    const periodicSrc = !dom.dist.targetLocDom.member(i+L) && dom.periodic;
+    return (!zeroTuple(L) && myLocDom.myBlock.size > 0 &&
+            (periodicSrc || dom.dist.targetLocDom.member(N)), periodicSrc);
+  }
+
+  var numRuns = 0;
+  for (D, N, L) in zip(myLocDom.Dest, myLocDom.Neighs, myLocDom.NeighDom) do
+    if fluffSource(N, L)(1) then numRuns += D.size / D.dim(rank).length;
+
+  myLocArr.fluffRunDom = {0..#numRuns};
+  ref runs = myLocArr.fluffRuns;
+  var start = 0;
+  for (S, D, N, L) in zip(myLocDom.Src, myLocDom.Dest, myLocDom.Neighs,
+                          myLocDom.NeighDom) {
+    const (copied, periodicSrc) = fluffSource(N, L);
+    if !copied then continue;
+
+    const Src = if periodicSrc then S else D;
+    const n = D.size / D.dim(rank).length;
+    const runSize = D.dim(rank).length.safeCast(size_t) * sizeof(eltType);
+    var k = start;
+    for d in D do
+      if chpl__tuplify(d)(rank) == D.dim(rank).first {
+        runs[k].dst = c_ptrTo(myLocArr.myElems[d]): c_void_ptr;
+        runs[k].size = runSize;
+        runs[k].corner = isCornerNeighbor(L);
+        k += 1;
+      }
+
+    // The source addresses are only known on the owner
+    const owner = locArr[N];
+    var srcs: [start..#n] c_void_ptr;
+    on owner {
+      const ownerSrc = Src;
+      var addrs: [start..#n] c_void_ptr;
+      var k = start;
+      for s in ownerSrc do
+        if chpl__tuplify(s)(rank) == ownerSrc.dim(rank).first {
+          addrs[k] = c_ptrTo(owner.myElems[s]): c_void_ptr;
+          k += 1;
+        }
+      srcs = addrs;
+    }
+    const node = owner.locale.id: chpl_nodeID_t;
+    for k in start..#n {
+      runs[k].node = node;
+      runs[k].src = srcs[k];
+    }
+    start += n;
+  }
+
+  myLocArr.fluffRunsValid = true;
+}
+
 proc StencilArr.dsiReindex(d: StencilDom) {
   var alias = new StencilArr(eltType=eltType, rank=d.rank, idxType=d.idxType,
                            stridable=d.stridable, dom=d);
@@ -1646,6 +1852,8 @@ proc StencilArr.dsiReallocate(d: domain) {
 proc StencilArr.dsiPostReallocate() {
   // Call this *after* the domain has been reallocated
   if doRADOpt then setupRADOpt();
+  coforall i in dom.dist.targetLocDom do
+    on locArr[i] do locArr[i].fluffRunsValid = false;
 }
 
 proc StencilArr.setRADOpt(val=true) {
@@ -1938,6 +2146,7 @@ proc Stencil.dsiTargetLocales() {
 // Stencil subdomains are continuous
 
 proc StencilArr.dsiHasSingleLocalSubdomain() param return true;
+proc StencilArr.doiCanScan() param return true;
 proc StencilDom.dsiHasSingleLocalSubdomain() param return true;
 
 // returns the current locale's subdomain
@@ -1970,163 +2179,44 @@ proc StencilDom.numRemoteElems(rlo,rid){
   return(bhi - (rlo - 1):idxType);
 }
 
-//For assignments of the form: "any = Stencil"
-//Currently not used, instead we use: doiBulkTransferFrom()
-proc StencilArr.doiBulkTransferTo(Barg)
-{
-  if debugStencilDistBulkTransfer then
-    writeln("In StencilArr.doiBulkTransferTo()");
-  
-  const B = this, A = Barg._value;
-  type el = B.idxType;
-  coforall i in B.dom.dist.targetLocDom do // for all locales
-    on B.dom.dist.targetLocales(i)
-      {
-        var regionB = B.dom.locDoms(i).myBlock;
-        if regionB.numIndices>0
-        {
-          const ini=bulkCommConvertCoordinate(regionB.first, B, A);
-          const end=bulkCommConvertCoordinate(regionB.last, B, A);
-          const sa=chpl__tuplify(A.dom.locDoms(i).myBlock.stride);
-          
-          var r1,r2: rank * range(idxType = el,stridable = true);
-          r2=regionB.dims();
-           //In the case that the number of elements in dimension t for r1 and r2
-           //were different, we need to calculate the correct stride in r1
-          for param t in 1..rank {
-            r1[t] = (ini[t]:el..end[t]:el by sa[t]:el);
-            if r1[t].length != r2[t].length then
-              r1[t] = (ini[t]:el..end[t]:el by (end[t] - ini[t]):el/(r2[t].length-1));
-          }
-        
-          if debugStencilDistBulkTransfer then
-            writeln("A",(...r1),".FromDR",regionB);
-    
-          Barg[(...r1)]._value.doiBulkTransferFromDR(B.locArr[i].myElems);
-        }
-      }
+//
+// Strided bulk transfer: each locale's piece is the block it owns,
+// not including its fluff.  See bulkCommTransfer() in DefaultRectangular.
+//
+proc StencilArr.doiBulkTransferPieceLocDom() return dom.dist.targetLocDom;
+proc StencilArr.doiBulkTransferPieceLocale(i) return dom.dist.targetLocales(i);
+proc StencilArr.doiBulkTransferNumPieces(i) return 1;
+iter StencilArr.doiBulkTransferPieces(i) {
+  yield locArr(i).myElems._value.doiBulkTransferPiece(
+                                   dom.locDoms(i).myBlock.dims());
 }
 
-//For assignments of the form: "Stencil = any" 
+//For assignments of the form: "Stencil = any"
 //where "any" means any array that implements the bulk transfer interface
 proc StencilArr.doiBulkTransferFrom(Barg)
 {
   if debugStencilDistBulkTransfer then
     writeln("In StencilArr.doiBulkTransferFrom()");
- 
-  const A = this, B = Barg._value;
-  type el = A.idxType;
-  coforall i in A.dom.dist.targetLocDom do // for all locales
-    on A.dom.dist.targetLocales(i)
-    {
-      var regionA = A.dom.locDoms(i).myBlock;
-      if regionA.numIndices>0
-      {
-        const ini=bulkCommConvertCoordinate(regionA.first, A, B);
-        const end=bulkCommConvertCoordinate(regionA.last, A, B);
-        const sb=chpl__tuplify(B.dom.locDoms(i).myBlock.stride);
-        
-        var r1,r2: rank * range(idxType = el,stridable = true);
-        r2=regionA.dims();
-         //In the case that the number of elements in dimension t for r1 and r2
-         //were different, we need to calculate the correct stride in r1
-        for param t in 1..rank{
-            r1[t] = (ini[t]:el..end[t]:el by sb[t]:el);
-            if r1[t].length != r2[t].length then
-              r1[t] = (ini[t]:el..end[t]:el by (end[t] - ini[t]):el/(r2[t].length-1));
-        }
-      
-        if debugStencilDistBulkTransfer then
-            writeln("B{",(...r1),"}.ToDR",regionA);
-   
-        Barg[(...r1)]._value.doiBulkTransferToDR(A.locArr[i].myElems[regionA]);
-      }
-    }
+
+  bulkCommTransfer(this, Barg._value);
 }
- 
-//For assignments of the form: DR = Stencil 
-//(default rectangular array = block distributed array)
+
+//For assignments of the form: DR = Stencil
+//(default rectangular array = stencil distributed array)
 proc StencilArr.doiBulkTransferToDR(Barg)
 {
   if debugStencilDistBulkTransfer then
     writeln("In StencilArr.doiBulkTransferToDR()");
 
-  const A = this, B = Barg._value; //Always it is a DR
-  type el = A.idxType;
-  coforall j in A.dom.dist.targetLocDom do
-    on A.dom.dist.targetLocales(j)
-    {
-      const inters=A.dom.locDoms(j).myBlock;
-      if(inters.numIndices>0)
-      {
-        const ini=bulkCommConvertCoordinate(inters.first, A, B);
-        const end=bulkCommConvertCoordinate(inters.last, A, B);
-        const sa = chpl__tuplify(B.dom.dsiStride);
-  
-        var r1,r2: rank * range(idxType = el,stridable = true);
-        for param t in 1..rank
-        {
-          r2[t] = (chpl__tuplify(inters.first)[t]
-                   ..chpl__tuplify(inters.last)[t]
-                   by chpl__tuplify(inters.stride)[t]);
-          r1[t] = (ini[t]:el..end[t]:el by sa[t]:el);
-        }
-        
-        if debugStencilDistBulkTransfer then
-          writeln("A[",r1,"] = B[",r2,"]");
-      
-        const d ={(...r1)};
-        const slice = B.dsiSlice(d._value);
-        //Necessary to calculate the value of blk variable in DR
-        //with the new domain r1
-        slice.adjustBlkOffStrForNewDomain(d._value, slice);
-        
-        slice.doiBulkTransferStride(A.locArr[j].myElems[(...r2)]._value);
-        
-        delete slice;
-      }
-    }
+  bulkCommTransfer(Barg._value, this);
 }
 
-//For assignments of the form: Stencil = DR 
-//(block distributed array = default rectangular)
-proc StencilArr.doiBulkTransferFromDR(Barg) 
+//For assignments of the form: Stencil = DR
+//(stencil distributed array = default rectangular)
+proc StencilArr.doiBulkTransferFromDR(Barg)
 {
   if debugStencilDistBulkTransfer then
     writeln("In StencilArr.doiBulkTransferFromDR");
 
-  const A = this, B = Barg._value;
-  type el = A.idxType;
-  coforall j in A.dom.dist.targetLocDom do
-    on A.dom.dist.targetLocales(j)
-    {
-      const inters=A.dom.locDoms(j).myBlock;
-      if(inters.numIndices>0)
-      {
-        const ini=bulkCommConvertCoordinate(inters.first, A, B);
-        const end=bulkCommConvertCoordinate(inters.last, A, B);
-        const sb = chpl__tuplify(B.dom.dsiStride);
-        
-        var r1,r2: rank * range(idxType = el,stridable = true);
-        for param t in 1..rank
-        {
-          r2[t] = (chpl__tuplify(inters.first)[t]
-                   ..chpl__tuplify(inters.last)[t]
-                   by chpl__tuplify(inters.stride)[t]);
-          r1[t] = (ini[t]:el..end[t]:el by sb[t]:el);
-        }
-        
-        if debugStencilDistBulkTransfer then
-          writeln("A[",r2,"] = B[",r1,"]");
-          
-        const d ={(...r1)};
-        const slice = B.dsiSlice(d._value);
-        //this step it's necessary to calculate the value of blk variable in DR
-        //with the new domain r1
-        slice.adjustBlkOffStrForNewDomain(d._value, slice);
-        
-        A.locArr[j].myElems[(...r2)]._value.doiBulkTransferStride(slice);
-        delete slice;
-      }
-    }
+  bulkCommTransfer(this, Barg._value);
 }
@@ -137,10 +137,6 @@ module ChapelArray {
   use ChapelTuple;
   use ChapelLocale;
 
-  // Explicitly use a processor atomic, as most calls to this function are
-  // likely be on locale 0
-  pragma "no doc"
-  var numPrivateObjects: atomic_int64;
   pragma "no doc"
   param nullPid = -1;
 
@@ -157,11 +153,8 @@ module ChapelArray {
 
   // Toggles the functionality to perform strided bulk transfers involving
   // distributed arrays.
-  //
-  // Currently disabled due to observations of higher communication counts
-  // compared to element-by-element assignment.
   pragma "no doc"
-  config param useBulkTransferDist = false;
+  config param useBulkTransferDist = true;
 
   pragma "no doc" // no doc unless we decide to expose this
   config param arrayAsVecGrowthFactor = 1.5;
@@ -191,12 +184,15 @@ module ChapelArray {
   // without communication.
   proc _newPrivatizedClass(value) : int {
 
-    const n = numPrivateObjects.fetchAdd(1);
-
     const hereID = here.id;
     const privatizeData = value.dsiGetPrivatizeData();
-    on Locales[0] do
+    var n: int;
+    on Locales[0] {
+      // pids are reserved on locale 0, which reuses the pids of freed objects
+      extern proc chpl_reservePrivatizedPid(): int;
+      n = chpl_reservePrivatizedPid();
       _newPrivatizedClassHelp(value, value, n, hereID, privatizeData);
+    }
 
     proc _newPrivatizedClassHelp(parentValue, originalValue, n, hereID, privatizeData) {
       var newValue = originalValue;
@@ -230,6 +226,10 @@ module ChapelArray {
 
     on Locales[0] {
       _freePrivatizedClassHelp(pid, original);
+
+      // every locale has cleared pid by now, so it can be handed out again
+      extern proc chpl_releasePrivatizedPid(pid:int);
+      chpl_releasePrivatizedPid(pid);
     }
 
     proc _freePrivatizedClassHelp(pid, original) {
@@ -680,6 +680,11 @@ module ChapelDistribution {
     proc isDefaultRectangular() param return false;
     proc dsiSupportsBulkTransferInterface() param return false;
     proc doiCanBulkTransferStride() param return false;
+
+    // Can scans over this array be computed by chpl__parallelScan()?
+    // That requires element access from any locale and, to be
+    // efficient, locales owning contiguous runs of indices.
+    proc doiCanScan() param return false;
   }
 
   /*
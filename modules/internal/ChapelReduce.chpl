@@ -36,6 +36,186 @@ module ChapelReduce {
     }
     delete op;
   }
+
+  //
+  // Entry point for non-zippered scan expressions; see buildScanExpr()
+  // in compiler/AST/build.cpp, which also issues the serialization
+  // warning based on chpl__scanSupportsPar().  A scan over a 1-D
+  // rectangular array is computed in parallel into a new array over the
+  // same domain when the operator supports it.  Anything else goes
+  // through the serial iterator above.
+  //
+  proc chpl__scan(op, data) {
+    if chpl__scanSupportsPar(op, data) then
+      return chpl__parallelScan(op, data);
+    else
+      return chpl__scanIterator(op, data);
+  }
+
+  //
+  // The parallel scan folds the running prefix of earlier chunks into
+  // each chunk's partial results with accumulateOntoState(), which
+  // requires the operator's state and result types to be the same.
+  //
+  proc chpl__scanSupportsPar(op, data) param {
+    use Reflection;
+    if !isArray(data) then
+      return false;
+    else if !isRectangularArr(data) then
+      return false;
+    else if !data._value.doiCanScan() then
+      return false;
+    else if data.rank != 1 then
+      return false;
+    else if !canResolveMethod(op, "clone") ||
+            !canResolveMethod(op, "identity") then
+      return false;
+    else if op.generate().type != op.identity.type then
+      return false;
+    else
+      return canResolveMethod(op, "accumulateOntoState",
+                              op.identity, op.identity);
+  }
+
+  // Can each of the array's target locales report the indices it owns
+  // as a single local subdomain?
+  proc chpl__scanHasLocalPieces(data) param {
+    if data._value.isDefaultRectangular() then
+      return false;
+    else
+      return data.hasSingleLocalSubdomain();
+  }
+
+  //
+  // Work-efficient parallel scan of a 1-D rectangular array.
+  //
+  // The index range is cut into contiguous chunks.  When the array's
+  // distribution gives each locale one contiguous run of indices (e.g.
+  // Block), the chunks are carved out of those runs and processed on
+  // the owning locale; otherwise the whole range is chunked here.
+  //
+  //   1. each task scans its chunk with a clone of 'op'
+  //   2. the chunk totals are exclusively prefix-scanned, in index order
+  //   3. each task folds the prefix of the chunks before it into its
+  //      chunk's results
+  //
+  // 'op' is consumed, as in the serial scan iterators.
+  //
+  proc chpl__parallelScan(op, data) {
+    use DSIUtil;
+
+    type resType = op.generate().type;
+    type idxType = data.domain.idxType;
+    const dom = data.domain;
+    const rng = dom.dim(1);
+    var res: [dom] resType;
+
+    if rng.size == 0 {
+      delete op;
+      return res;
+    }
+
+    //
+    // Gather one contiguous piece of the range per owning locale,
+    // falling back to a single piece on this locale.
+    //
+    var pieceDom = {0..0};
+    var pieceLoc: [pieceDom] locale;
+    var pieceFirst, pieceLast: [pieceDom] idxType;
+    var pieceChunks: [pieceDom] int;
+
+    var usePieces = false;
+    if chpl__scanHasLocalPieces(data) {
+      const targetLocs = data.targetLocales();
+      pieceDom = {0..#targetLocs.size};
+      var pieceOK: [pieceDom] bool;
+      coforall (loc, i) in zip(targetLocs, pieceDom) do on loc {
+        const mine = data.localSubdomain().dim(1);
+        pieceLoc[i] = loc;
+        if mine.size == 0 {
+          pieceOK[i] = true;
+        } else {
+          pieceOK[i] = mine.size == 1 || mine.stride == rng.stride;
+          pieceFirst[i] = mine.first;
+          pieceLast[i] = mine.last;
+          pieceChunks[i] = _computeNumChunks(mine.size);
+        }
+      }
+      var covered = 0;
+      for i in pieceDom do
+        if pieceChunks[i] > 0 then
+          covered += rng[pieceFirst[i]..pieceLast[i]].size;
+      usePieces = covered == rng.size && && reduce pieceOK;
+    }
+    if !usePieces {
+      pieceDom = {0..0};
+      pieceLoc[0] = here;
+      pieceFirst[0] = rng.first;
+      pieceLast[0] = rng.last;
+      pieceChunks[0] = _computeNumChunks(rng.size);
+    }
+
+    // Order the pieces by position in the range.  There is one per
+    // locale, so a quadratic ranking is fine.
+    var pieceOrder: [pieceDom] int;
+    for i in pieceDom do
+      for j in pieceDom do
+        if pieceChunks[j] > 0 && pieceChunks[i] > 0 &&
+           rng.indexOrder(pieceFirst[j]) < rng.indexOrder(pieceFirst[i]) then
+          pieceOrder[i] += 1;
+
+    const maxChunks = max reduce pieceChunks;
+    var chunkState: [pieceDom.dim(1), 0..#maxChunks] resType;
+
+    proc chunkOf(piece, chunk) {
+      const sub = rng[pieceFirst[piece]..pieceLast[piece]];
+      const (lo, hi) = _computeBlock(sub.size, pieceChunks[piece],
+                                     chunk, sub.size-1);
+      return sub#(hi+1)#-(hi-lo+1);
+    }
+
+    // 1. per-chunk scans
+    coforall piece in pieceDom do on pieceLoc[piece] {
+      coforall chunk in 0..#pieceChunks[piece] {
+        const myop = op.clone();
+        const myRange = chunkOf(piece, chunk);
+        for i in myRange {
+          myop.accumulate(data[i]);
+          res[i] = myop.generate();
+        }
+        chunkState[piece, chunk] = res[myRange.last];
+        delete myop;
+      }
+    }
+
+    // 2. exclusive scan of the chunk totals, in range order
+    var next: resType = op.identity;
+    for rank in pieceDom {
+      for piece in pieceDom {
+        if pieceOrder[piece] != rank || pieceChunks[piece] == 0 then
+          continue;
+        for chunk in 0..#pieceChunks[piece] {
+          const total = chunkState[piece, chunk];
+          chunkState[piece, chunk] = next;
+          op.accumulateOntoState(next, total);
+        }
+      }
+    }
+
+    // 3. fold each chunk's prefix into its results
+    coforall piece in pieceDom do on pieceLoc[piece] {
+      coforall chunk in 0..#pieceChunks[piece] {
+        if pieceOrder[piece] != 0 || chunk != 0 {
+          const prefix = chunkState[piece, chunk];
+          for i in chunkOf(piece, chunk) do
+            op.accumulateOntoState(res[i], prefix);
+        }
+      }
+    }
+
+    delete op;
+    return res;
+  }
   
   proc chpl__reduceCombine(globalOp, localOp) {
     on globalOp {
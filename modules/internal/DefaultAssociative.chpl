@@ -33,6 +33,14 @@ module DefaultAssociative {
      DefaultAssociativeDom? */
   enum chpl__hash_status { empty, full, deleted };
 
+  // For parSafe domains, the status of each slot is mirrored in an
+  // atomic word so that adds and removes can claim slots without
+  // holding the table lock.  'busy' marks a slot that is being filled.
+  param chpl__assoc_slot_empty = 0,
+        chpl__assoc_slot_full = 1,
+        chpl__assoc_slot_deleted = 2,
+        chpl__assoc_slot_busy = 3;
+
   record chpl_TableEntry {
     type idxType;
     var status: chpl__hash_status = chpl__hash_status.empty;
@@ -63,18 +71,50 @@ module DefaultAssociative {
     // by design a distributed data structure
     var numEntries: atomic_int64;
     var tableLock: atomicbool; // do not access directly, use function below
+    var tableSharers: atomic_int64; // ditto
     var tableSizeNum = 1;
     var tableSize = chpl__primes(tableSizeNum);
     var tableDom = {0..tableSize-1};
     var table: [tableDom] chpl_TableEntry(idxType);
-  
+
+    // Atomic mirror of table[].status, only allocated for parSafe domains.
+    // Whenever tableDom is reassigned (with the table locked) stateDom
+    // must be reassigned to match.
+    var stateDom = if parSafe then tableDom else {0..-1};
+    var slotState: [stateDom] atomic_int64;
+
+    //
+    // For parSafe domains, the table lock is a reader/writer gate.
+    // Operations that only touch individual slots (member, add, remove,
+    // array access) hold it in shared mode and synchronize per-slot
+    // through slotState.  Operations that rebuild the table (resize,
+    // clear, requestCapacity) hold it exclusively.
+    //
+    // A task holding the lock in shared mode must release it before
+    // trying to acquire it exclusively.
+    //
     inline proc lockTable() {
       while tableLock.testAndSet() do chpl_task_yield();
+      while tableSharers.read() != 0 do chpl_task_yield();
     }
   
     inline proc unlockTable() {
       tableLock.clear();
     }
+
+    inline proc lockTableShared() {
+      while true {
+        while tableLock.read() do chpl_task_yield();
+        tableSharers.add(1);
+        if !tableLock.read() then return;
+        // lost the race with an exclusive locker; back off and retry
+        tableSharers.sub(1);
+      }
+    }
+
+    inline proc unlockTableShared() {
+      tableSharers.sub(1);
+    }
   
     // TODO: An ugly [0..-1] domain appears several times in the code --
     //       replace with a named constant/param?
@@ -272,6 +312,8 @@ module DefaultAssociative {
         for slot in tableDom {
           table[slot].status = chpl__hash_status.empty;
         }
+        if parSafe then
+          for state in slotState do state.write(chpl__assoc_slot_empty);
         numEntries.write(0);
         if parSafe then unlockTable();
       }
@@ -305,22 +347,81 @@ module DefaultAssociative {
       const inSlot = slotNum;
       var retVal = 0;
       on this {
-        const shouldLock = !haveLock && parSafe;
-        if shouldLock then lockTable();
-        var findAgain = shouldLock;
-        if ((numEntries.read()+1)*2 > tableSize) {
-          _resize(grow=true);
-          findAgain = true;
+        if !haveLock && parSafe {
+          (slotNum, retVal) = _addConcurrent(idx);
+        } else {
+          var findAgain = false;
+          if ((numEntries.read()+1)*2 > tableSize) {
+            _resize(grow=true);
+            findAgain = true;
+          }
+          if findAgain then
+            (slotNum, retVal) = _add(idx, -1);
+          else
+            (_, retVal) = _add(idx, inSlot);
         }
-        if findAgain then
-          (slotNum, retVal) = _add(idx, -1);
-        else
-          (_, retVal) = _add(idx, inSlot);
-        if shouldLock then unlockTable();
       }
       return (slotNum, retVal);
     }
 
+    // Adds 'idx' to a parSafe domain while holding the table lock only in
+    // shared mode.  An empty slot is claimed by moving its state from
+    // empty to busy, so two tasks adding the same index serialize on the
+    // first empty slot in its probe sequence.  Deleted slots are not
+    // reused here; they are dropped the next time the table is resized.
+    //
+    // NOTE: Calls to this routine assume that the table lock is not held.
+    //
+    proc _addConcurrent(idx: idxType) {
+      while true {
+        lockTableShared();
+        const needResize = (numEntries.read()+1)*2 > tableSize &&
+                           !postponeResize;
+        if !needResize {
+          for slotNum in _lookForSlots(idx) {
+            var state = slotState[slotNum].read();
+            while true {
+              if state == chpl__assoc_slot_busy {
+                chpl_task_yield();
+                state = slotState[slotNum].read();
+              } else if state == chpl__assoc_slot_empty {
+                if slotState[slotNum].compareExchangeStrong(
+                                        chpl__assoc_slot_empty,
+                                        chpl__assoc_slot_busy) {
+                  table[slotNum].idx = idx;
+                  table[slotNum].status = chpl__hash_status.full;
+                  numEntries.add(1);
+                  slotState[slotNum].write(chpl__assoc_slot_full);
+                  unlockTableShared();
+                  return (slotNum, 1);
+                }
+                state = slotState[slotNum].read();
+              } else {
+                break;
+              }
+            }
+            if state == chpl__assoc_slot_full && table[slotNum].idx == idx {
+              unlockTableShared();
+              return (slotNum, 0);
+            }
+          }
+        }
+        unlockTableShared();
+
+        // Either the table is too full or the probe sequence is exhausted
+        // (e.g. by deleted slots).  Rebuild it exclusively and try again.
+        lockTable();
+        if postponeResize && !needResize {
+          unlockTable();
+          halt("couldn't add ", idx, " -- ", numEntries.read(), " / ", tableSize, " taken");
+        }
+        if !needResize || (numEntries.read()+1)*2 > tableSize then
+          _resize(grow=true);
+        unlockTable();
+      }
+      return (-1, 0);
+    }
+
     // This routine adds new indices without checking the table size and
     //  is thus appropriate for use by routines like _resize().
     //
@@ -333,6 +434,7 @@ module DefaultAssociative {
       if foundSlot {
         table[slotNum].status = chpl__hash_status.full;
         table[slotNum].idx = idx;
+        if parSafe then slotState[slotNum].write(chpl__assoc_slot_full);
         numEntries.add(1);
       } else {
         if (slotNum < 0) {
@@ -348,20 +450,54 @@ module DefaultAssociative {
     proc dsiRemove(idx: idxType) {
       var retval = 1;
       on this {
-        if parSafe then lockTable();
-        const (foundSlot, slotNum) = _findFilledSlot(idx, haveLock=parSafe);
-        if (foundSlot) {
-          for a in _arrs do
-            a.clearEntry(idx, true);
+        if parSafe {
+          retval = _removeConcurrent(idx);
+        } else {
+          const (foundSlot, slotNum) = _findFilledSlot(idx, haveLock=true);
+          if (foundSlot) {
+            for a in _arrs do
+              a.clearEntry(idx, true);
+            table[slotNum].status = chpl__hash_status.deleted;
+            numEntries.sub(1);
+          } else {
+            retval = 0;
+          }
+          if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+            _resize(grow=false);
+          }
+        }
+      }
+      return retval;
+    }
+
+    // Removes 'idx' from a parSafe domain while holding the table lock
+    // only in shared mode.  If several tasks remove the same index, the
+    // one that moves its slot from full to deleted wins.
+    //
+    // NOTE: Calls to this routine assume that the table lock is not held.
+    //
+    proc _removeConcurrent(idx: idxType) {
+      var retval = 0;
+      lockTableShared();
+      const (foundSlot, slotNum) = _findFilledSlot(idx, haveLock=true);
+      if foundSlot {
+        for a in _arrs do
+          a.clearEntry(idx, true);
+        if slotState[slotNum].compareExchangeStrong(chpl__assoc_slot_full,
+                                                    chpl__assoc_slot_deleted) {
           table[slotNum].status = chpl__hash_status.deleted;
           numEntries.sub(1);
-        } else {
-          retval = 0;
+          retval = 1;
         }
+      }
+      unlockTableShared();
+
+      if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+        lockTable();
         if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
           _resize(grow=false);
         }
-        if parSafe then unlockTable();
+        unlockTable();
       }
       return retval;
     }
@@ -400,10 +536,12 @@ module DefaultAssociative {
 
           // Do not preserve entries
           tableDom = {0..-1};
+          if parSafe then stateDom = {0..-1};
 
           tableSizeNum = primeLoc;
           tableSize = prime;
           tableDom = {0..tableSize-1};
+          if parSafe then stateDom = tableDom;
 
           //numEntries will be reconstructed as keys are readded
           numEntries.write(0);
@@ -420,6 +558,7 @@ module DefaultAssociative {
           tableSizeNum=primeLoc;
           tableSize=prime;
           tableDom = {0..tableSize-1};
+          if parSafe then stateDom = tableDom;
         }
 
         //Unlock the table
@@ -459,11 +598,13 @@ module DefaultAssociative {
   
       // grow original table
       tableDom = {0..(-1:chpl_table_index_type)}; // non-preserving resize
+      if parSafe then stateDom = {0..(-1:chpl_table_index_type)};
       numEntries.write(0); // reset, because the adds below will re-set this
       tableSizeNum += if grow then 1 else -1;
       if tableSizeNum > chpl__primes.size then halt("associative array exceeds maximum size");
       tableSize = chpl__primes(tableSizeNum);
       tableDom = {0..tableSize-1};
+      if parSafe then stateDom = tableDom;
   
       // insert old data into newly resized table
       for slot in _fullSlots(copyTable) {
@@ -479,29 +620,46 @@ module DefaultAssociative {
     // Returns true if found, along with the first open slot that may be
     // re-used for faster addition to the domain
     proc _findFilledSlot(idx: idxType, param haveLock = false) : (bool, index(tableDom)) {
-      if parSafe && !haveLock then lockTable();
+      if parSafe && !haveLock then lockTableShared();
       var firstOpen = -1;
       for slotNum in _lookForSlots(idx, table.domain.high+1) {
-        const slotStatus = table[slotNum].status;
+        const slotStatus = _slotStatus(slotNum);
         // if we encounter a slot that's empty, our element could not
         // be found past this point.
         if (slotStatus == chpl__hash_status.empty) {
           if firstOpen == -1 then firstOpen = slotNum;
-          if parSafe && !haveLock then unlockTable();
+          if parSafe && !haveLock then unlockTableShared();
           return (false, firstOpen);
         } else if (slotStatus == chpl__hash_status.full) {
           if (table[slotNum].idx == idx) {
-            if parSafe && !haveLock then unlockTable();
+            if parSafe && !haveLock then unlockTableShared();
             return (true, slotNum);
           }
         } else { // this entry was removed, but is the first slot we could use
           if firstOpen == -1 then firstOpen = slotNum;
         }
       }
-      if parSafe && !haveLock then unlockTable();
+      if parSafe && !haveLock then unlockTableShared();
       return (false, -1);
     }
 
+    // Returns the status of a slot.  For parSafe domains this reads the
+    // atomic slot state, waiting out any concurrent add that is filling
+    // the slot.
+    inline proc _slotStatus(slotNum: index(tableDom)) {
+      if !parSafe then return table[slotNum].status;
+      var state = slotState[slotNum].read();
+      while state == chpl__assoc_slot_busy {
+        chpl_task_yield();
+        state = slotState[slotNum].read();
+      }
+      select state {
+        when chpl__assoc_slot_full do return chpl__hash_status.full;
+        when chpl__assoc_slot_deleted do return chpl__hash_status.deleted;
+        otherwise do return chpl__hash_status.empty;
+      }
+    }
+
     //
     // NOTE: Calls to this routine assume that the tableLock has been acquired.
     //
@@ -567,18 +725,23 @@ module DefaultAssociative {
     // ref version
     proc dsiAccess(idx : idxType, haveLock = false) ref {
       const shouldLock = dom.parSafe && !haveLock;
-      if shouldLock then dom.lockTable();
+      if shouldLock then dom.lockTableShared();
       var (found, slotNum) = dom._findFilledSlot(idx, haveLock=true);
       if found {
-        if shouldLock then dom.unlockTable();
+        if shouldLock then dom.unlockTableShared();
         return data(slotNum);
       } else if slotNum != -1 { // do an insert using the slot we found
         if dom._arrs.length != 1 {
           halt("cannot implicitly add to an array's domain when the domain is used by more than one array: ", dom._arrs.length);
           return data(0);
+        } else if shouldLock {
+          // the add may need to resize the table, which requires
+          // exclusive access, so give up the shared lock first
+          dom.unlockTableShared();
+          const (newSlot, _) = dom._addWrapper(idx);
+          return data(newSlot);
         } else {
           const (newSlot, _) = dom._addWrapper(idx, slotNum, haveLock=true);
-          if shouldLock then dom.unlockTable();
           return data(newSlot);
         }
       } else {
@@ -591,10 +754,10 @@ module DefaultAssociative {
     proc dsiAccess(idx : idxType, haveLock = false)
     where !shouldReturnRvalueByConstRef(eltType) {
       const shouldLock = dom.parSafe && !haveLock;
-      if shouldLock then dom.lockTable();
+      if shouldLock then dom.lockTableShared();
       var (found, slotNum) = dom._findFilledSlot(idx, haveLock=true);
       if found {
-        if shouldLock then dom.unlockTable();
+        if shouldLock then dom.unlockTableShared();
         return data(slotNum);
       } else {
         halt("array index out of bounds: ", idx);
@@ -605,10 +768,10 @@ module DefaultAssociative {
     proc dsiAccess(idx : idxType, haveLock = false) const ref
     where shouldReturnRvalueByConstRef(eltType) {
       const shouldLock = dom.parSafe && !haveLock;
-      if shouldLock then dom.lockTable();
+      if shouldLock then dom.lockTableShared();
       var (found, slotNum) = dom._findFilledSlot(idx, haveLock=true);
       if found {
-        if shouldLock then dom.unlockTable();
+        if shouldLock then dom.unlockTableShared();
         return data(slotNum);
       } else {
         halt("array index out of bounds: ", idx);
@@ -2164,6 +2164,7 @@ module DefaultRectangular {
   }
 
   proc DefaultRectangularArr.dsiSupportsBulkTransfer() param return true;
+  proc DefaultRectangularArr.doiCanScan() param return true;
   proc DefaultRectangularArr.dsiSupportsBulkTransferInterface() param return true;
 
   proc DefaultRectangularArr.doiCanBulkTransfer() {
@@ -2566,4 +2567,334 @@ module DefaultRectangular {
     return result;
   }
 
+
+  //
+  // Strided bulk transfer involving distributed arrays.
+  //
+  // A distributed array takes part by describing its storage as a set
+  // of pieces.  A piece is a rectangular set of indices held in a
+  // single ddata, such that a step along any dimension of the piece is
+  // a constant distance in the ddata.  The array provides:
+  //
+  //   doiBulkTransferPieceLocDom()  - domain of piece-owner indices
+  //   doiBulkTransferPieceLocale(i) - the locale owning the i-th set
+  //   doiBulkTransferNumPieces(i)   - upper bound on that set's size
+  //   doiBulkTransferPieces(i)      - yields the pieces in that set;
+  //                                   called on their locale
+  //
+  // bulkCommTransfer(A, B) copies B into A.  It gathers the pieces of
+  // B, then on each locale owning pieces of A intersects its pieces
+  // with those of B in A's index space, and moves each nonempty overlap
+  // with one strided GET.  No distributed slices are created, so the
+  // only on-statements are one per owning locale of each side.
+  //
+  record bulkCommPiece {
+    param rank: int;
+    type idxType;
+    type eltType;
+    var region: rank*range(idxType, stridable=true);
+    var data: _ddata(eltType);
+    var first: int;         // data index of region's first element
+    var stride: rank*int;   // data index distance of one region step
+  }
+
+  proc DefaultRectangularArr.doiBulkTransferPieceLocDom() return {0..0};
+  proc DefaultRectangularArr.doiBulkTransferPieceLocale(i) return this.locale;
+  proc DefaultRectangularArr.doiBulkTransferNumPieces(i) return 1;
+  iter DefaultRectangularArr.doiBulkTransferPieces(i) {
+    yield doiBulkTransferPiece(dom.dsiDims());
+  }
+
+  //
+  // The piece of this array holding the indices in 'dims'.  Assumes
+  // the array has a single ddata.
+  //
+  proc DefaultRectangularArr.doiBulkTransferPiece(dims) {
+    var p: bulkCommPiece(rank, idxType, eltType);
+    var lo: rank*idxType;
+    for param i in 1..rank {
+      p.region(i) = dims(i);
+      lo(i) = dims(i).first;
+    }
+    if p.region(1).length == 0 then return p;
+    for param i in 2..rank do
+      if p.region(i).length == 0 then return p;
+
+    p.data = dataChunk(0);
+    p.first = getDataIndex(lo, getShifted=false, getChunked=false): int;
+    for param i in 1..rank {
+      var next = lo;
+      next(i) = (next(i): int + dims(i).stride): idxType;
+      p.stride(i) = getDataIndex(next, getShifted=false,
+                                 getChunked=false): int - p.first;
+    }
+    return p;
+  }
+
+  // This locale's copy of array object X, given X's privatized ID.
+  inline proc bulkCommHere(X, pid) {
+    if _isPrivatized(X) then
+      return chpl_getPrivatizedCopy(X.type, pid);
+    else
+      return X;
+  }
+
+  proc bulkCommTransfer(A, B) {
+    param srcRank = B.rank;
+    const srcLocDom = B.doiBulkTransferPieceLocDom();
+    var srcStart: [srcLocDom] int;
+    var numSrc = 0;
+    for i in srcLocDom {
+      srcStart(i) = numSrc;
+      numSrc += B.doiBulkTransferNumPieces(i);
+    }
+
+    //
+    // The pieces are kept in bare ddatas so that each owner can write
+    // its own and each destination locale can fetch them all with one
+    // GET, without touching a remote domain.
+    //
+    const srcPieces = _ddata_allocate(bulkCommPiece(srcRank, B.idxType,
+                                                    B.eltType), numSrc);
+    const Apid = A.pid, Bpid = B.pid;
+    coforall i in srcLocDom {
+      const start = srcStart(i);
+      on B.doiBulkTransferPieceLocale(i) {
+        const myB = bulkCommHere(B, Bpid);
+        var k = start;
+        for p in myB.doiBulkTransferPieces(i) {
+          srcPieces[k] = p;
+          k += 1;
+        }
+      }
+    }
+
+    const Adims = A.dom.dsiDims(), Bdims = B.dom.dsiDims();
+    coforall i in A.doiBulkTransferPieceLocDom() do
+      on A.doiBulkTransferPieceLocale(i) {
+        const myA = bulkCommHere(A, Apid);
+        const mySrcPieces = if srcPieces.locale.id == here.id then srcPieces
+                            else _ddata_allocate(srcPieces[0].type, numSrc);
+        if mySrcPieces != srcPieces then
+          __primitive("chpl_comm_array_get", mySrcPieces[0],
+                      srcPieces.locale.id, srcPieces[0], numSrc);
+        for dst in myA.doiBulkTransferPieces(i) do
+          forall k in 0..#numSrc do
+            bulkCommCopy(dst, Adims, mySrcPieces[k], Bdims);
+        if mySrcPieces != srcPieces then
+          _ddata_free(mySrcPieces);
+      }
+
+    _ddata_free(srcPieces);
+  }
+
+  //
+  // Copy the part of piece 'src' (of an array with dimensions 'Bdims')
+  // that overlaps piece 'dst' (of an array with dimensions 'Adims'),
+  // matching indices by their order in each dimension.
+  //
+  proc bulkCommCopy(dst, Adims, src, Bdims) {
+    param rank = dst.rank;
+    type idxType = dst.idxType;
+
+    if src.data == nil || dst.data == nil then return;
+
+    var count, dstStr, srcStr: rank*int;
+    var dstOff = dst.first, srcOff = src.first;
+    for param i in 1..rank {
+      const ar = Adims(i), br = Bdims(i);
+      const aStr = ar.stride: int, bStr = br.stride: int;
+      const af = ar.first: int, bf = br.first: int;
+      inline proc toA(b: int) return af + (b - bf) / bStr * aStr;
+      inline proc toB(a: int) return bf + (a - af) / aStr * bStr;
+
+      // src's region, in A's index space
+      const sr = src.region(i);
+      const lo = toA(sr.first: int), hi = toA(sr.last: int);
+      const srA = min(lo, hi):idxType..max(lo, hi):idxType
+                  by (if sr.length > 1 then sr.stride / bStr * aStr else aStr);
+
+      const inter = dst.region(i)(srA);
+      if inter.length == 0 then return;
+      count(i) = inter.length: int;
+
+      const dr = dst.region(i);
+      const first = inter.first: int;
+      dstOff += (first - dr.first: int) / dr.stride * dst.stride(i);
+      srcOff += (toB(first) - sr.first: int) / sr.stride * src.stride(i);
+      if count(i) > 1 {
+        dstStr(i) = inter.stride / dr.stride * dst.stride(i);
+        srcStr(i) = inter.stride / aStr * bStr / sr.stride * src.stride(i);
+      }
+    }
+
+    const dstLoc = dst.data.locale.id, srcLoc = src.data.locale.id;
+    if dstLoc == here.id && srcLoc == here.id {
+      bulkCommLocalCopy(dst.data, dstOff, dstStr, src.data, srcOff, srcStr,
+                        count);
+      return;
+    }
+
+    //
+    // The runtime's strides are unsigned, so walk any dimension that
+    // runs backwards in the destination the other way round.  If the
+    // source then runs backwards, copy that dimension a plane at a time.
+    //
+    for param i in 1..rank {
+      if dstStr(i) < 0 {
+        dstOff += (count(i) - 1) * dstStr(i);
+        srcOff += (count(i) - 1) * srcStr(i);
+        dstStr(i) = -dstStr(i);
+        srcStr(i) = -srcStr(i);
+      }
+    }
+    for param i in 1..rank {
+      if srcStr(i) < 0 {
+        var c = count;
+        c(i) = 1;
+        for k in 0..#count(i) do
+          bulkCommStrided(dst.data, dstOff + k * dstStr(i), dstStr,
+                          src.data, srcOff + k * srcStr(i), srcStr, c);
+        return;
+      }
+    }
+    bulkCommStrided(dst.data, dstOff, dstStr, src.data, srcOff, srcStr, count);
+  }
+
+  // Copy between two ddatas on this locale, with the same arguments as
+  // bulkCommStrided().
+  proc bulkCommLocalCopy(dstData, dstOff: int, dstStr, srcData, srcOff: int,
+                         srcStr, count) {
+    param rank = count.size;
+    var ords: rank*range;
+    for param i in 1..rank do ords(i) = 0..#count(i);
+    forall k in {(...ords)} {
+      const kk = chpl__tuplify(k);
+      var d = dstOff, s = srcOff;
+      for param i in 1..rank {
+        d += kk(i) * dstStr(i);
+        s += kk(i) * srcStr(i);
+      }
+      dstData[d] = srcData[s];
+    }
+  }
+
+  //
+  // Copy 'count' elements of 'src', starting at data index 'srcOff'
+  // and stepping by 'srcStr' elements in each dimension, to the
+  // corresponding elements of 'dst'.  Neither stride may be negative.
+  // This is one strided GET or PUT, unless the local side is strided
+  // where the remote side is contiguous: then the elements go through
+  // a dense local buffer, so that they move in longer runs.
+  //
+  proc bulkCommStrided(dstData, dstOff: int, dstStr, srcData, srcOff: int,
+                       srcStr, count) {
+    param rank = count.size;
+
+    if dstData.locale.id != here.id && srcData.locale.id != here.id {
+      on dstData do
+        bulkCommStrided(dstData, dstOff, dstStr, srcData, srcOff, srcStr,
+                        count);
+      return;
+    }
+
+    var dense: rank*int;
+    var size = 1;
+    for param i in 1..rank by -1 {
+      dense(i) = size;
+      size *= count(i);
+    }
+
+    const dstLocal = dstData.locale.id == here.id;
+    const run = bulkCommRunLength(count, dstStr, srcStr),
+          stagedRun = if dstLocal then bulkCommRunLength(count, dense, srcStr)
+                      else bulkCommRunLength(count, dstStr, dense);
+    if stagedRun <= run {
+      bulkCommIssue(dstData, dstOff, dstStr, srcData, srcOff, srcStr, count);
+    } else if dstLocal {
+      const buf = _ddata_allocate(dstData[0].type, size);
+      bulkCommIssue(buf, 0, dense, srcData, srcOff, srcStr, count);
+      bulkCommLocalCopy(dstData, dstOff, dstStr, buf, 0, dense, count);
+      _ddata_free(buf);
+    } else {
+      const buf = _ddata_allocate(srcData[0].type, size);
+      bulkCommLocalCopy(buf, 0, dense, srcData, srcOff, srcStr, count);
+      bulkCommIssue(dstData, dstOff, dstStr, buf, 0, dense, count);
+      _ddata_free(buf);
+    }
+  }
+
+  //
+  // Fold the dimensions that are contiguous in both ddatas together, as
+  // in stridedTransferFrom().  Fills in the runtime's count and stride
+  // arrays and returns the number of stride levels.
+  //
+  proc bulkCommFold(count, dstStr, srcStr, ref cnt, ref dstStride,
+                    ref srcStride) {
+    param rank = count.size;
+    var stridelevels = 0;
+    for c in cnt do c = 1;
+    for i in 1..rank by -1 {
+      const n = count(i);
+      if n == 1 then continue;
+      const dstRun = if stridelevels == 0 then cnt[1]: int
+                     else dstStride[stridelevels]: int * cnt[stridelevels+1]: int;
+      const srcRun = if stridelevels == 0 then cnt[1]: int
+                     else srcStride[stridelevels]: int * cnt[stridelevels+1]: int;
+      if dstStr(i) == dstRun && srcStr(i) == srcRun {
+        cnt[stridelevels+1] *= n.safeCast(size_t);
+      } else {
+        stridelevels += 1;
+        dstStride[stridelevels] = dstStr(i).safeCast(size_t);
+        srcStride[stridelevels] = srcStr(i).safeCast(size_t);
+        cnt[stridelevels+1] = n.safeCast(size_t);
+      }
+    }
+    return stridelevels;
+  }
+
+  // The number of elements in each contiguous run of a strided copy.
+  proc bulkCommRunLength(count, dstStr, srcStr) {
+    param rank = count.size;
+    var cnt: [1..rank+1] size_t;
+    var dstStride, srcStride: [1..rank] size_t;
+    bulkCommFold(count, dstStr, srcStr, cnt, dstStride, srcStride);
+    return cnt[1]: int;
+  }
+
+  // Issue the strided GET or PUT for bulkCommStrided().
+  proc bulkCommIssue(dstData, dstOff: int, dstStr, srcData, srcOff: int,
+                     srcStr, count) {
+    param rank = count.size;
+    var cnt: [1..rank+1] size_t;
+    var dstStride, srcStride: [1..rank] size_t;
+    const stridelevels = bulkCommFold(count, dstStr, srcStr, cnt, dstStride,
+                                      srcStride);
+
+    const dststr = dstStride._value.dataChunk(0);
+    const srcstr = srcStride._value.dataChunk(0);
+    const cntp = cnt._value.dataChunk(0);
+    if dstData.locale.id == here.id {
+      const srclocale = srcData.locale.id: int(32);
+      __primitive("chpl_comm_get_strd",
+                  dstData[dstOff],
+                  dststr[0],
+                  srclocale,
+                  srcData[srcOff],
+                  srcstr[0],
+                  cntp[0],
+                  stridelevels: int(32));
+    } else {
+      const destlocale = dstData.locale.id: int(32);
+      __primitive("chpl_comm_put_strd",
+                  dstData[dstOff],
+                  dststr[0],
+                  destlocale,
+                  srcData[srcOff],
+                  srcstr[0],
+                  cntp[0],
+                  stridelevels: int(32));
+    }
+  }
+
 }
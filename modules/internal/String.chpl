@@ -85,6 +85,13 @@ module String {
   private extern const CHPL_RT_MD_STR_COPY_REMOTE: chpl_mem_descInt_t;
   private extern const CHPL_RT_MD_STR_COPY_DATA: chpl_mem_descInt_t;
 
+  private extern proc chpl_string_find(haystack: c_void_ptr, hlen: int,
+                                       needle: c_void_ptr, nlen: int): int;
+  private extern proc chpl_string_rfind(haystack: c_void_ptr, hlen: int,
+                                        needle: c_void_ptr, nlen: int): int;
+  private extern proc chpl_string_count(haystack: c_void_ptr, hlen: int,
+                                        needle: c_void_ptr, nlen: int): int;
+
   private inline proc chpl_string_comm_get(dest: bufferType, src_loc_id: int(64),
                                            src_addr: bufferType, len: integral) {
     __primitive("chpl_comm_get", dest, src_loc_id, src_addr, len.safeCast(size_t));
@@ -518,8 +525,6 @@ module String {
 
 
     // Helper function that uses a param bool to toggle between count and find
-    //TODO: this could be a much better string search
-    //      (Boyer-Moore-Horspool|any thing other than brute force)
     //
     pragma "no doc"
     inline proc _search_helper(needle: string, region: range(?),
@@ -559,27 +564,43 @@ module String {
           localRet = 0;
           const localNeedle: string = needle.localize();
 
-          // i *is not* an index into anything, it is the order of the element
-          // of view we are searching from.
-          const numPossible = thisLen - nLen + 1;
-          const searchSpace = if fromLeft
-              then 0..#(numPossible)
-              else 0..#(numPossible) by -1;
-          for i in searchSpace {
-            // j *is* the index into the localNeedle's buffer
-            for j in 0..#nLen {
-              const idx = view.orderToIndex(i+j); // 1s based idx
-              if this.buff[idx-1] != localNeedle.buff[j] then break;
-
-              if j == nLen-1 {
-                if count {
-                  localRet += 1;
-                } else { // find
-                  localRet = view.orderToIndex(i);
+          if view.stride == 1 {
+            // Contiguous regions are searched by the runtime
+            const viewLow = view.low: int;
+            const hay = this.buff + (viewLow - 1);
+            if count {
+              localRet = chpl_string_count(hay, thisLen,
+                                           localNeedle.buff, nLen);
+            } else {
+              const offset = if fromLeft
+                then chpl_string_find(hay, thisLen, localNeedle.buff, nLen)
+                else chpl_string_rfind(hay, thisLen, localNeedle.buff, nLen);
+              if offset >= 0 then
+                localRet = viewLow + offset;
+            }
+          } else {
+            // i *is not* an index into anything, it is the order of the element
+            // of view we are searching from.
+            const numPossible = thisLen - nLen + 1;
+            const searchSpace = if fromLeft
+                then 0..#(numPossible)
+                else 0..#(numPossible) by -1;
+            for i in searchSpace {
+              // j *is* the index into the localNeedle's buffer
+              for j in 0..#nLen {
+                const idx = view.orderToIndex(i+j); // 1s based idx
+                if this.buff[idx-1] != localNeedle.buff[j] then break;
+
+                if j == nLen-1 {
+                  if count {
+                    localRet += 1;
+                  } else { // find
+                    localRet = view.orderToIndex(i);
+                  }
                 }
               }
+              if !count && localRet != 0 then break;
             }
-            if !count && localRet != 0 then break;
           }
         }
         ret = localRet;
@@ -635,23 +656,56 @@ module String {
       :returns: a copy of the string where `needle` replaces `replacement` up
                 to `count` times
      */
-    // TODO: not ideal - count and single allocation probably faster
-    //                 - can special case on replacement|needle.length (0, 1)
     proc replace(needle: string, replacement: string, count: int = -1) : string {
-      var result: string = this;
-      var found: int = 0;
-      var startIdx: int = 1;
+      const localThis: string = this.localize();
       const localNeedle: string = needle.localize();
       const localReplacement: string = replacement.localize();
+      const thisLen = localThis.len,
+            nLen = localNeedle.len,
+            rLen = localReplacement.len;
+
+      // Count the occurrences to replace so the result is allocated once
+      var found: int = 0;
+      if nLen != 0 {
+        var pos: int = 0;
+        while (count < 0) || (found < count) {
+          const offset = chpl_string_find(localThis.buff + pos, thisLen - pos,
+                                          localNeedle.buff, nLen);
+          if offset < 0 then break;
+
+          found += 1;
+          pos += offset + nLen;
+        }
+      }
+
+      if found == 0 {
+        var result: string = this;
+        return result;
+      }
 
-      while (count < 0) || (found < count) {
-        const idx = result.find(localNeedle, startIdx..);
-        if !idx then break;
+      var result: string;
+      result.len = thisLen + found * (rLen - nLen);
+      const allocSize = chpl_here_good_alloc_size(result.len + 1);
+      result._size = allocSize;
+      result.buff = chpl_here_alloc(allocSize,
+                                    CHPL_RT_MD_STR_COPY_DATA): bufferType;
 
-        found += 1;
-        result = result[..idx-1] + localReplacement + result[(idx + localNeedle.length)..];
-        startIdx = idx + localReplacement.length;
+      var src: int = 0,
+          dst: int = 0;
+      for 1..found {
+        const offset = chpl_string_find(localThis.buff + src, thisLen - src,
+                                        localNeedle.buff, nLen);
+        c_memcpy(result.buff + dst, localThis.buff + src, offset);
+        dst += offset;
+        if rLen != 0 {
+          c_memcpy(result.buff + dst, localReplacement.buff, rLen);
+          dst += rLen;
+        }
+        src += offset + nLen;
       }
+      c_memcpy(result.buff + dst, localThis.buff + src, thisLen - src);
+      result.buff[result.len] = 0;
+
       return result;
     }
 
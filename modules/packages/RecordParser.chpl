@@ -196,6 +196,53 @@ class RecordReader {
     } while(once);
   }
 
+  /* Yield the records read, in parallel, as in
+     ``forall r in M.stream()``.  The rest of the channel's region is
+     split into byte ranges that are each searched by a separate task
+     with its own unlocked channel.  A record belongs to the range in
+     which the first task to find it started, so each record is yielded
+     once.  Records are not yielded in order.
+   */
+  iter stream(param tag: iterKind) where tag == iterKind.standalone {
+    const f = myReader._getFile();
+    const start = myReader.offset();
+    const end = myReader._regionEnd(f);
+    if end < start {
+      for r in stream() do yield r;
+    } else {
+      const nchunks = _parallelReadChunks(end - start);
+      const style = myReader._style();
+      on myReader.home {
+        // The task for range i starts searching at lo(i).  The first
+        // record it finds is identified by the offset where reading
+        // it stopped; the task for range i-1 stops before that record.
+        proc lo(i) return start + ((end - start) * i) / nchunks;
+        var firstEnd:[0..nchunks] int(64);
+        firstEnd[nchunks] = max(int(64));
+        forall i in 0..nchunks-1 {
+          var rd = f.reader(kind=myReader.kind, locking=false,
+                            start=lo(i), end=end, style=style);
+          var (rec, once) = _get_internal(rd, 0, -1);
+          firstEnd[i] = if once then rd.offset() else max(int(64));
+          rd.close();
+        }
+        for i in 1..nchunks do firstEnd[i] = max(firstEnd[i], firstEnd[i-1]);
+
+        coforall i in 0..nchunks-1 {
+          var rd = f.reader(kind=myReader.kind, locking=false,
+                            start=lo(i), end=end, style=style);
+          while true {
+            var (rec, once) = _get_internal(rd, 0, -1);
+            if !once || rd.offset() >= firstEnd[i+1] then break;
+            yield rec;
+          }
+          rd.close();
+        }
+      }
+      myReader.advance(end - start);
+    }
+  }
+
   /*
 
      An internal function that we use with all our user visible code.  When
@@ -207,11 +254,17 @@ class RecordReader {
    */
   pragma "no doc"
   proc _get_internal(offst: int(64) = 0, len: int(64) = -1) { 
+    return _get_internal(myReader, offst, len);
+  }
+
+  // As above, but reading from the channel rd.
+  pragma "no doc"
+  proc _get_internal(rd, offst: int(64), len: int(64)) {
     var rec: t; // create record
     var once = false; // We havent populated yet
     // This will only loop through  at most one time before returning
     // FEATURE REQUEST: Make this so we don't need a for loop here
-    for m in myReader.matches(matchRegexp, num_fields, 1) {
+    for m in rd.matches(matchRegexp, num_fields, 1) {
       if (((m(1).offset) >= offst+len) && len != -1) { // rec.start >= start + len
         // Then break and dont return any record
         return (rec, false);
@@ -219,7 +272,7 @@ class RecordReader {
       for param n in 1..num_fields {
         var tmp = __primitive("field by num", rec, n);
         var s: string;
-        myReader.extractMatch(m(n + 1), s);
+        rd.extractMatch(m(n + 1), s);
         if(s == "") 
           then __primitive("field by num", rec, n) = tmp;
         else __primitive("field by num", rec, n) = s:tmp.type;
@@ -269,13 +269,135 @@ proc chpl_check_comparator(comparator, type eltType) {
 }
 
 
+pragma "no doc"
+/*
+   Returns ``true`` if the keys that `comparator` sorts elements of type
+   `eltType` by are integral or real values, in which case the data can be
+   sorted with :proc:`radixSort`.
+ */
+proc chpl_radixSortable(comparator, type eltType) param {
+  use Reflection;
+
+  // Dummy data for checking method resolution
+  const data: eltType;
+
+  if canResolveMethod(comparator, "key", data) then
+    return chpl_isRadixKeyType(comparator.key(data).type);
+  else if comparator.type == DefaultComparator then
+    return chpl_isRadixKeyType(eltType);
+  else
+    return false;
+}
+
+
+pragma "no doc"
+proc chpl_isRadixKeyType(type keyType) param {
+  return isIntegralType(keyType) || isRealType(keyType);
+}
+
+
+pragma "no doc"
+/*
+   Map a radix sort key onto a ``uint(64)`` whose unsigned order matches the
+   order of the key.  Signed integers are biased by their minimum value, so
+   narrow keys keep their high bytes clear.  Reals use their IEEE bits with
+   every bit of a negative value flipped and just the sign bit of a positive
+   value flipped.
+ */
+inline proc chpl_radixKeyBits(key): uint(64) {
+  type keyType = key.type;
+  if isUintType(keyType) {
+    return key: uint(64);
+  } else if isIntType(keyType) {
+    return (key: int(64)): uint(64) - (min(keyType): int(64)): uint(64);
+  } else {
+    const bits = __primitive("real2int", key: real(64)): uint(64);
+    if (bits >> 63) != 0 then
+      return ~bits;
+    else
+      return bits | (1: uint(64) << 63);
+  }
+}
+
+
+pragma "no doc"
+/* Unsigned bits of the radix sort key of element `a` */
+inline proc chpl_radixKey(a, comparator): uint(64) {
+  use Reflection;
+
+  if canResolveMethod(comparator, "key", a) then
+    return chpl_radixKeyBits(comparator.key(a));
+  else
+    return chpl_radixKeyBits(a);
+}
+
+
+pragma "no doc"
+/*
+   Number of 8-bit digits :proc:`radixSort` has to look at for keys of
+   `keyType`.  Reals are always compared via their 64-bit representation.
+ */
+proc chpl_radixNumDigits(type keyType) param {
+  if isRealType(keyType) then
+    return 8;
+  else
+    return numBits(keyType) / 8;
+}
+
+
+pragma "no doc"
+proc chpl_radixKeyType(comparator, type eltType) type {
+  use Reflection;
+
+  const data: eltType;
+
+  if canResolveMethod(comparator, "key", data) then
+    return comparator.key(data).type;
+  else
+    return eltType;
+}
+
+
+pragma "no doc"
+/*
+   Returns ``true`` if `Data` is a distributed array whose elements can be
+   gathered per locale via its local subdomains.
+ */
+proc chpl_sampleSortable(Data) param {
+  if Data._value.isDefaultRectangular() then
+    return false;
+  else
+    return Data.hasSingleLocalSubdomain();
+}
+
+
+pragma "no doc"
+/* Sort an array held by a single locale with the best applicable routine */
+proc chpl_localSort(Data: [?Dom] ?eltType, comparator) {
+  if chpl_radixSortable(comparator, eltType) then
+    radixSort(Data, comparator=comparator);
+  else
+    quickSort(Data, comparator=comparator);
+}
+
+
+pragma "no doc"
+/* Block of elements owned by one locale during a :proc:`sampleSort` */
+class chpl_SortBucket {
+  type eltType;
+  var D: domain(1);
+  var A: [D] eltType;
+}
+
+
 /* Basic Functions */
 
 /*
    General purpose sorting interface.
 
-   .. note:: Currently this method calls a sequential :proc:`quickSort`, but
-             this may change the future as other algorithms are implemented.
+   Distributed arrays are sorted with :proc:`sampleSort`.  Other arrays are
+   sorted with the parallel :proc:`radixSort` when their sort keys are
+   integral or real values, and with :proc:`quickSort` otherwise.
 
    :arg Data: The array to be sorted
    :type Data: [] `eltType`
@@ -284,7 +406,10 @@ proc chpl_check_comparator(comparator, type eltType) {
 
  */
 proc sort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
-  quickSort(Data, comparator=comparator);
+  if chpl_sampleSortable(Data) then
+    sampleSort(Data, comparator=comparator);
+  else
+    chpl_localSort(Data, comparator);
 }
 
 
@@ -700,6 +825,265 @@ proc quickSort(Data: [?Dom] ?eltType, minlen=16, comparator:?rec=defaultComparat
 }
 
 
+/*
+   Sort the 1D array `Data` in-place using a parallel least-significant-digit
+   radix sort.
+
+   Elements are ordered by their key, which is the result of
+   ``comparator.key(a)`` if the comparator defines a ``key`` method and the
+   element itself otherwise.  Keys must be integral or real values.  Elements
+   with equal keys keep their relative order.
+
+   Each pass sorts on 8 bits of the key: every task counts the digits in its
+   block of the data, the counts are turned into per-task output offsets, and
+   the tasks then scatter their blocks into a scratch array.  Passes in which
+   all keys have the same digit are skipped.
+
+   :arg Data: The array to be sorted
+   :type Data: [] `eltType`
+   :arg comparator: :ref:`Comparator <comparators>` record that defines how the
+      data is sorted.  It must define a ``key`` method or be the default
+      comparator.
+
+ */
+proc radixSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
+  use DSIUtil;
+
+  chpl_check_comparator(comparator, eltType);
+  if !chpl_radixSortable(comparator, eltType) then
+    compilerError("radixSort() requires integral or real sort keys");
+
+  param radixBits = 8,
+        radix = 1 << radixBits,
+        numDigits = chpl_radixNumDigits(chpl_radixKeyType(comparator, eltType));
+
+  const n = Dom.size;
+  if n < 2 then return;
+
+  // Sort dense copies so strided and distributed arrays are only touched
+  // when copying in and out
+  var A, B: [0..#n] eltType;
+  A = Data;
+
+  const numTasks = max(1, _computeNumChunks(n));
+  var counts: [0..#radix, 0..#numTasks] int;
+
+  inline proc digitOf(a, shift) {
+    return ((chpl_radixKey(a, comparator) >> shift) & (radix-1):uint(64)): int;
+  }
+
+  // Scatter Src into Dst ordered by the given digit.  Returns false without
+  // touching Dst if every key has the same digit.
+  proc radixPass(Src, Dst, digit) {
+    const shift = digit * radixBits;
+
+    coforall tid in 0..#numTasks {
+      const (lo, hi) = _computeBlock(n, numTasks, tid, n-1);
+      var myCounts: [0..#radix] int;
+      for i in lo..hi do
+        myCounts[digitOf(Src[i], shift)] += 1;
+      counts[0..#radix, tid] = myCounts;
+    }
+
+    // Exclusive scan in (digit, task) order gives each task's offsets
+    var total = 0;
+    for d in 0..#radix {
+      const digitStart = total;
+      for tid in 0..#numTasks {
+        const count = counts[d, tid];
+        counts[d, tid] = total;
+        total += count;
+      }
+      if total - digitStart == n then
+        return false;
+    }
+
+    coforall tid in 0..#numTasks {
+      const (lo, hi) = _computeBlock(n, numTasks, tid, n-1);
+      var offsets: [0..#radix] int = counts[0..#radix, tid];
+      for i in lo..hi {
+        const d = digitOf(Src[i], shift);
+        Dst[offsets[d]] = Src[i];
+        offsets[d] += 1;
+      }
+    }
+    return true;
+  }
+
+  var inA = true;
+  for digit in 0..#numDigits {
+    const moved = if inA then radixPass(A, B, digit)
+                  else radixPass(B, A, digit);
+    if moved then
+      inA = !inA;
+  }
+
+  if inA then
+    Data = A;
+  else
+    Data = B;
+}
+
+
+pragma "no doc"
+/* Error message for multi-dimension arrays */
+proc radixSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
+  where Dom.rank != 1 {
+    compilerError("radixSort() requires 1-D array");
+}
+
+
+/*
+   Sort the 1D distributed array `Data` in-place using a parallel sample sort.
+
+   Each locale sorts the elements it owns, and splitters are chosen from
+   regularly spaced samples of the sorted blocks.  The splitters divide every
+   block into one bucket per locale.  Each locale then gathers its bucket from
+   all locales in bulk, sorts it, and writes it to its part of the sorted
+   order, so elements move between locales only once.  Local sorts use
+   :proc:`radixSort` when the sort keys allow it and :proc:`quickSort`
+   otherwise.
+
+   Arrays that are not distributed are sorted on the current locale.
+
+   :arg Data: The array to be sorted
+   :type Data: [] `eltType`
+   :arg comparator: :ref:`Comparator <comparators>` record that defines how the
+      data is sorted.
+
+ */
+proc sampleSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
+  chpl_check_comparator(comparator, eltType);
+
+  if chpl_sampleSortable(Data) then
+    chpl_sampleSort(Data, comparator);
+  else
+    chpl_localSort(Data, comparator);
+}
+
+
+pragma "no doc"
+/* Error message for multi-dimension arrays */
+proc sampleSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
+  where Dom.rank != 1 {
+    compilerError("sampleSort() requires 1-D array");
+}
+
+
+pragma "no doc"
+proc chpl_sampleSort(Data: [?Dom] ?eltType, comparator) {
+  // Samples taken from each locale's sorted block
+  param samplesPerLocale = 64;
+
+  const n = Dom.size;
+  if n < 2 then return;
+
+  const targetLocs = Data.targetLocales();
+  const numLocs = targetLocs.size;
+  const locDom = {0..#numLocs};
+  const locs: [locDom] locale = targetLocs;
+
+  if numLocs == 1 {
+    chpl_localSort(Data, comparator);
+    return;
+  }
+
+  const rng = Dom.dim(1);
+
+  // Copy each locale's elements into a block it owns and sort them there
+  var blocks: [locDom] chpl_SortBucket(eltType);
+  var samples: [0..#numLocs, 0..#samplesPerLocale] eltType;
+  var sampleCounts: [locDom] int;
+  coforall l in locDom do on locs[l] {
+    const mine = Data.localSubdomain();
+    const m = mine.size;
+    const block = new chpl_SortBucket(eltType=eltType, D={0..#m});
+    if m > 0 {
+      block.A = Data[mine];
+      chpl_localSort(block.A, comparator);
+    }
+
+    const k = min(m, samplesPerLocale);
+    var mySamples: [0..#k] eltType;
+    for s in 0..#k do
+      mySamples[s] = block.A[((2*s+1)*m) / (2*k)];
+    if k > 0 then
+      samples[l, 0..#k] = mySamples;
+    sampleCounts[l] = k;
+    blocks[l] = block;
+  }
+
+  // Choose numLocs-1 splitters from the sorted samples
+  var allSamples: [0..#(+ reduce sampleCounts)] eltType;
+  var next = 0;
+  for l in locDom {
+    for s in 0..#sampleCounts[l] {
+      allSamples[next] = samples[l, s];
+      next += 1;
+    }
+  }
+  chpl_localSort(allSamples, comparator);
+
+  const numSamples = allSamples.size;
+  var splitters: [0..numLocs-2] eltType;
+  for i in 0..numLocs-2 do
+    splitters[i] = allSamples[((i+1)*numSamples) / numLocs];
+
+  // Bucket d of locale l is blocks[l].A[bounds[l, d]..bounds[l, d+1]-1]
+  var bounds: [0..#numLocs, 0..numLocs] int;
+  coforall l in locDom do on locs[l] {
+    const block = blocks[l];
+    const mySplitters = splitters;
+    const m = block.D.size;
+    var myBounds: [0..numLocs] int;
+    myBounds[numLocs] = m;
+    for d in 1..numLocs-1 {
+      // the first element greater than the splitter starts the bucket
+      var lo = myBounds[d-1],
+          hi = m;
+      while lo < hi {
+        const mid = lo + (hi - lo) / 2;
+        if chpl_compare(block.A[mid], mySplitters[d-1], comparator) <= 0 then
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      myBounds[d] = lo;
+    }
+    bounds[l, 0..numLocs] = myBounds;
+  }
+
+  // Locale d owns positions recvStart[d]..#recvSize[d] of the sorted order
+  var recvSize, recvStart: [locDom] int;
+  for d in locDom do
+    for l in locDom do
+      recvSize[d] += bounds[l, d+1] - bounds[l, d];
+  for d in 1..numLocs-1 do
+    recvStart[d] = recvStart[d-1] + recvSize[d-1];
+
+  coforall d in locDom do on locs[d] {
+    const size = recvSize[d];
+    if size > 0 {
+      var Recv: [0..#size] eltType;
+      var pos = 0;
+      for l in locDom {
+        const lo = bounds[l, d],
+              count = bounds[l, d+1] - lo;
+        if count > 0 {
+          Recv[pos..#count] = blocks[l].A[lo..#count];
+          pos += count;
+        }
+      }
+      chpl_localSort(Recv, comparator);
+      Data[rng # (recvStart[d] + size) # -size] = Recv;
+    }
+  }
+
+  coforall l in locDom do on locs[l] do
+    delete blocks[l];
+}
+
+
 /*
    Sort the 1D array `Data` in-place using a sequential selection sort
    algorithm.
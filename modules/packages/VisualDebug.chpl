@@ -45,13 +45,22 @@ module VisualDebug
   */
   config const VisualDebugOn = DefaultVisualDebugOn;
 
+  /*
+    If this is `true`, the data files are written in a compact binary
+    format, buffered per thread, which perturbs the program less and is
+    faster for :ref:`chplvis` to load.  If `false`, the older text format
+    is written.  Both formats can be read by :ref:`chplvis`.
+  */
+  config const VisualDebugBinary = true;
+
   private extern proc chpl_now_time():real;
 
   //
   // Data Generation for the Visual Debug tool  (offline)
   //
 
-  private extern proc chpl_vdebug_start (rootname: c_string, time:real);
+  private extern proc chpl_vdebug_start (rootname: c_string, time:real,
+                                         binary: c_int);
 
   private extern proc chpl_vdebug_stop ();
 
@@ -101,7 +110,8 @@ private proc VDebugTree (what: vis_op, name: string, time: real, tagno: int,
 
      /* Do the op at the root  */
      select what {
-         when vis_op.v_start    do chpl_vdebug_start (name.localize().c_str(), time);
+         when vis_op.v_start    do chpl_vdebug_start (name.localize().c_str(), time,
+                                                   VisualDebugBinary: c_int);
          when vis_op.v_stop     do chpl_vdebug_stop ();
          when vis_op.v_tag      do chpl_vdebug_tag (tagno);
          when vis_op.v_pause    do chpl_vdebug_pause (tagno);
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+  This module provides support for aggregating small remote updates.
+
+  A program that does many small, independent remote writes, such as
+  scattering values into a distributed array or updating a distributed
+  histogram, spends most of its time waiting for the network to carry
+  each one.  An :class:`Aggregator` instead collects the updates bound
+  for each locale in a buffer, and sends each buffer as a single message
+  when it fills.  The updates are applied at their destinations when the
+  messages arrive.
+
+  For example, this computes a histogram of a block-distributed array of
+  random indices into another block-distributed array::
+
+    use Aggregation;
+
+    forall r in rindex.domain.targetLocales() do on r {
+      var agg = new Aggregator();
+      for i in rindex.localSubdomain() do
+        agg.add(hist[rindex[i]], 1);
+      delete agg;
+    }
+
+  Updates made through an aggregator are only guaranteed to be visible
+  once the aggregator has been flushed, either explicitly by calling
+  :proc:`Aggregator.flush` or by deleting it.  An update to the same
+  location made directly (rather than through the aggregator) before the
+  flush may take effect before or after the aggregated one, and two
+  aggregated updates to the same location between flushes may take effect
+  in either order.  Aggregated additions commute, so this only matters
+  for :proc:`Aggregator.put`.
+
+  Each aggregator may only be used by one task at a time, and only on
+  the locale where it was created.  Parallel loops should create one
+  aggregator per task, as in the example above.
+ */
+module Aggregation
+{
+  private extern proc chpl_comm_agg_create(): c_void_ptr;
+  private extern proc chpl_comm_agg_put(agg: c_void_ptr, node: chpl_nodeID_t,
+                                        raddr: c_void_ptr, addr: c_void_ptr,
+                                        size: size_t);
+  private extern proc chpl_comm_agg_add_int64(agg: c_void_ptr,
+                                              node: chpl_nodeID_t,
+                                              raddr: c_void_ptr,
+                                              val: int(64));
+  private extern proc chpl_comm_agg_flush(agg: c_void_ptr);
+  private extern proc chpl_comm_agg_destroy(agg: c_void_ptr);
+  private extern proc sizeof(type x): size_t;
+
+  /*
+    Collects remote updates into per-locale buffers and sends each
+    buffer as a single message.
+   */
+  class Aggregator {
+    pragma "no doc"
+    var agg: c_void_ptr = chpl_comm_agg_create();
+
+    /*
+      Assign `src` to `dst`, which may be on any locale.  `dst` must have
+      a numeric or ``bool`` type.
+     */
+    proc put(ref dst: ?t, src: t) where isNumericType(t) || isBoolType(t) {
+      var val = src;
+      chpl_comm_agg_put(agg, __primitive("_wide_get_node", dst),
+                        __primitive("_wide_get_addr", dst),
+                        c_ptrTo(val): c_void_ptr, sizeof(t));
+    }
+
+    /*
+      Add `val` to `dst`, which may be on any locale.  Aggregated
+      additions to the same location are applied atomically with respect
+      to each other, but not with respect to any other kind of update.
+     */
+    proc add(ref dst: int(64), val: int(64)) {
+      chpl_comm_agg_add_int64(agg, __primitive("_wide_get_node", dst),
+                              __primitive("_wide_get_addr", dst), val);
+    }
+
+    /*
+      Send any buffered updates, and wait until all of the updates made
+      through this aggregator so far have been applied.
+     */
+    proc flush() {
+      chpl_comm_agg_flush(agg);
+    }
+
+    pragma "no doc"
+    proc ~Aggregator() {
+      chpl_comm_agg_destroy(agg);
+    }
+  }
+}
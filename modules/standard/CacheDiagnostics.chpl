@@ -0,0 +1,184 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+  This module provides support for counting the activity of the cache
+  for remote data, which is enabled with the ``--cache-remote`` compiler
+  flag.  It complements :mod:`CommDiagnostics`: that module counts the
+  GETs and PUTs that actually reach the network, while this one counts
+  how the cache satisfied the GETs and PUTs the program asked for.
+  Together they show whether enabling the cache helps a given program.
+
+  Counting works the same way as communication counting.  Counting
+  across all locales is done like this::
+
+    // (optional) if we counted previously, reset the counters to zero
+    resetCacheDiagnostics();
+    startCacheDiagnostics();
+    // between start/stop calls, count cache events on any locale
+    stopCacheDiagnostics();
+    // retrieve the counts and report the results
+    writeln(getCacheDiagnostics());
+
+  Each locale's counts are shared by all of the tasks running there.
+  The ``Here`` variants of these procedures count on just the calling
+  locale.  When the program was not compiled with ``--cache-remote``, or
+  the cache is not supported by the current configuration, all of the
+  counts are zero.
+
+  GETs are counted once for each cache page they touch, so a large GET
+  may produce several events.
+ */
+module CacheDiagnostics
+{
+  /* Aggregated remote data cache event counts.  This record type is
+     defined in the same way by both the runtime and this module.  This
+     definition duplicates the one in the runtime.
+   */
+  extern record chpl_cacheDiagnostics {
+    /*
+      GETs satisfied entirely from the cache
+     */
+    var get_hits: uint(64);
+    /*
+      GETs for which the page was cached but some of the requested
+      lines had to be fetched
+     */
+    var get_partial_hits: uint(64);
+    /*
+      GETs for which the page was not cached
+     */
+    var get_misses: uint(64);
+    /*
+      sequential readahead windows started by the cache
+     */
+    var readahead_issued: uint(64);
+    /*
+      readahead windows that a later GET actually reached
+     */
+    var readahead_used: uint(64);
+    /*
+      explicit prefetch requests
+     */
+    var prefetches: uint(64);
+    /*
+      PUTs started to write dirty data back to its home locale
+     */
+    var dirty_flushes: uint(64);
+    /*
+      pages evicted from the queue of pages seen only once
+     */
+    var ain_evictions: uint(64);
+    /*
+      pages evicted from the queue of pages seen more than once
+     */
+    var am_evictions: uint(64);
+    /*
+      cached pages that had to be fetched again because an acquire
+      fence (such as a sync variable read or the start of an ``on``
+      statement) happened after they were cached
+     */
+    var acquire_invalidations: uint(64);
+  };
+
+  /*
+    The Chapel record type inherits the runtime definition of it.
+   */
+  type cacheDiagnostics = chpl_cacheDiagnostics;
+
+  private extern proc chpl_startCacheDiagnosticsHere();
+
+  private extern proc chpl_stopCacheDiagnosticsHere();
+
+  private extern proc chpl_resetCacheDiagnosticsHere();
+
+  private extern proc chpl_getCacheDiagnosticsHere(out cd: cacheDiagnostics);
+
+  /*
+    Start counting remote data cache events across the whole program.
+   */
+  proc startCacheDiagnostics() {
+    for loc in Locales do on loc do
+      startCacheDiagnosticsHere();
+  }
+
+  /*
+    Stop counting remote data cache events across the whole program.
+   */
+  proc stopCacheDiagnostics() {
+    for loc in Locales do on loc do
+      stopCacheDiagnosticsHere();
+  }
+
+  /*
+    Start counting remote data cache events on this locale.
+   */
+  inline proc startCacheDiagnosticsHere() {
+    chpl_startCacheDiagnosticsHere();
+  }
+
+  /*
+    Stop counting remote data cache events on this locale.
+   */
+  inline proc stopCacheDiagnosticsHere() {
+    chpl_stopCacheDiagnosticsHere();
+  }
+
+  /*
+    Reset remote data cache event counts across the whole program.
+   */
+  proc resetCacheDiagnostics() {
+    for loc in Locales do on loc do
+      resetCacheDiagnosticsHere();
+  }
+
+  /*
+    Reset remote data cache event counts on the calling locale.
+   */
+  inline proc resetCacheDiagnosticsHere() {
+    chpl_resetCacheDiagnosticsHere();
+  }
+
+  /*
+    Retrieve remote data cache event counts for the whole program.
+
+    :returns: array of counts of cache events on each locale
+    :rtype: `[LocaleSpace] cacheDiagnostics`
+   */
+  proc getCacheDiagnostics() {
+    var D: [LocaleSpace] cacheDiagnostics;
+    for loc in Locales do on loc {
+      D(loc.id) = getCacheDiagnosticsHere();
+    }
+    return D;
+  }
+
+  /*
+    Retrieve remote data cache event counts for this locale.
+
+    :returns: counts of cache events on this locale
+    :rtype: `cacheDiagnostics`
+   */
+  proc getCacheDiagnosticsHere() {
+    var cd: cacheDiagnostics;
+    chpl_getCacheDiagnosticsHere(cd);
+    return cd;
+  }
+
+}
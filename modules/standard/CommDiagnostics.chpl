@@ -137,6 +137,34 @@
   was executed on locale 0, and a remote get and a remote put were
   executed on locale 1.
 
+  **Detailed Statistics**
+
+  While counting is on, each locale also keeps more detailed statistics
+  about the communication operations it initiates.  For each kind of
+  operation, as named by :type:`commOp`, it counts how many were sent to
+  each locale and keeps a histogram of their sizes in bytes.  For the
+  blocking operations (GETs, PUTs and the blocking execute_ons) it also
+  keeps a histogram of their latencies in nanoseconds.  Bucket 0 of a
+  histogram counts the values less than 2, and bucket `i` counts the
+  values `v` with ``2**i <= v < 2**(i+1)``, except that the last bucket
+  counts all the values too large for the others.  The sizes of
+  execute_ons are the sizes of their argument bundles.
+
+  These are started, stopped and reset along with the aggregate counts,
+  and are retrieved separately.  For example, this prints the number of
+  GETs each locale did from each other locale, as a matrix with one row
+  per initiating locale, followed by the latency histogram for the PUTs
+  done by locale 0::
+
+    startCommDiagnostics();
+    // ...
+    stopCommDiagnostics();
+    writeln(getCommMatrix(commOp.get));
+    writeln(getCommLatencyHistogramHere(commOp.put));
+
+  With ``CHPL_COMM=none`` there is no remote communication, so all of
+  these are zero.
+
   **Studying Communication During Module Initialization**
 
   It is hard for a programmer to determine exactly what happens during
@@ -242,6 +270,15 @@ module CommDiagnostics
 
   private extern proc chpl_getCommDiagnosticsHere(out cd: commDiagnostics);
 
+  private extern proc chpl_getCommSizeHistogramHere(op: int(32),
+                                                    buckets: c_ptr(uint(64)));
+
+  private extern proc chpl_getCommLatencyHistogramHere(op: int(32),
+                                                       buckets: c_ptr(uint(64)));
+
+  private extern proc chpl_getCommDestCountsHere(op: int(32),
+                                                 counts: c_ptr(uint(64)));
+
   /*
     Start on-the-fly reporting of communication initiated on any locale.
    */
@@ -331,6 +368,78 @@ module CommDiagnostics
     return cd;
   }
 
+  /*
+    The kinds of communication operation for which detailed statistics
+    are kept.  The values match the fields of :record:`commDiagnostics`
+    with the same names.
+   */
+  enum commOp {
+    get = 0, get_nb, put, put_nb, execute_on, execute_on_fast, execute_on_nb
+  };
+
+  /*
+    The number of buckets in each size or latency histogram.
+   */
+  param numCommHistogramBuckets = 32;
+
+  /*
+    Retrieve the histogram of the sizes, in bytes, of the operations of
+    kind `op` initiated on this locale.
+
+    :returns: count of operations in each histogram bucket
+    :rtype: `[0..#numCommHistogramBuckets] uint(64)`
+   */
+  proc getCommSizeHistogramHere(op: commOp) {
+    var H: [0..#numCommHistogramBuckets] uint(64);
+    chpl_getCommSizeHistogramHere(op: int(32), c_ptrTo(H));
+    return H;
+  }
+
+  /*
+    Retrieve the histogram of the latencies, in nanoseconds, of the
+    operations of kind `op` initiated on this locale.  This is all zeros
+    for the non-blocking operations.
+
+    :returns: count of operations in each histogram bucket
+    :rtype: `[0..#numCommHistogramBuckets] uint(64)`
+   */
+  proc getCommLatencyHistogramHere(op: commOp) {
+    var H: [0..#numCommHistogramBuckets] uint(64);
+    chpl_getCommLatencyHistogramHere(op: int(32), c_ptrTo(H));
+    return H;
+  }
+
+  /*
+    Retrieve the number of operations of kind `op` initiated on this
+    locale and sent to each locale.
+
+    :returns: count of operations sent to each locale
+    :rtype: `[LocaleSpace] uint(64)`
+   */
+  proc getCommDestCountsHere(op: commOp) {
+    var C: [LocaleSpace] uint(64);
+    chpl_getCommDestCountsHere(op: int(32), c_ptrTo(C));
+    return C;
+  }
+
+  /*
+    Retrieve the number of operations of kind `op` sent between each
+    pair of locales, across the whole program.  Element `(src, dst)` of
+    the result is the number initiated on locale `src` and sent to
+    locale `dst`.
+
+    :returns: counts of operations from each locale to each locale
+    :rtype: `[0..#numLocales, 0..#numLocales] uint(64)`
+   */
+  proc getCommMatrix(op: commOp) {
+    var M: [0..#numLocales, 0..#numLocales] uint(64);
+    for loc in Locales do on loc {
+      const C = getCommDestCountsHere(op);
+      M[loc.id, ..] = C;
+    }
+    return M;
+  }
+
   /*
     If this is set, on-the-fly reporting of communication operations
     will be turned on before any module initialization begins and
@@ -340,35 +340,11 @@ proc copyFile(out error: syserr, src: string, dest: string) {
     // The second argument is invalid if the two arguments are the same.
   }
 
-  // Open src for reading, open dest for writing
-  var srcFile = open(src, iomode.r);
-  var destFile = open(dest, iomode.cw);
-  var srcChnl = srcFile.reader(kind=ionative, locking=false);
-  var destChnl = destFile.writer(kind=ionative, locking=false);
-  // read in, write out.
-  var line: [0..1023] uint(8);
-  var numRead: int = 0;
-  while (srcChnl.readline(line, numRead=numRead, error=error)) {
-    // From mppf:
-    // If you want it to be faster, we can make it only buffer once (sharing
-    // the bytes read into memory between the two channels). To do that you'd
-    // do something like this (in a loop):
-
-    // srcReader.mark
-    // srcReader.advance( buffer size )
-    // srcReader.beginPeekBuffer to get the current buffer (qio_channel_begin_peek_buffer)
-    // dstWriter.putBuffer with the buffer we got (qio_channel_put_buffer)
-    // srcReader.endPeekBuffer
-
-    // Some of these routines don't exist with Chapel wrappers now
-
-    destChnl.write(line[0..#numRead]);
-  }
-  if error == EEOF then error = ENOERR;
-  destChnl.flush();
+  // The runtime copies the data without bringing it into user space when
+  // the OS supports that, and through a large buffer otherwise.
+  extern proc chpl_fs_copy_file(source: c_string, dest: c_string): syserr;
 
-  srcFile.close();
-  destFile.close();
+  error = chpl_fs_copy_file(src.localize().c_str(), dest.localize().c_str());
 }
 
 /* Copies the contents of the file indicated by `src` into the file indicated
@@ -418,39 +394,79 @@ proc copyMode(src: string, dest: string) {
   if err != ENOERR then ioerror(err, "in copyMode " + src, dest);
 }
 
-private proc copyTreeHelper(out error: syserr, src: string, dest: string, copySymbolically: bool=false) {
-  var oldMode = getMode(src);
-  mkdir(error, dest, mode=oldMode, parents=true);
-  if error != ENOERR then return;
-  // Create dest
+// The first error seen by any of the tasks copying a tree.  Tasks check
+// failed() to stop early, so it is read without the lock.
+pragma "no doc"
+class copyTreeState {
+  const copySymbolically: bool;
+  var error: syserr = ENOERR;
+  var lock$: sync bool = true;
+
+  proc failed() return error != ENOERR;
+
+  proc setError(err: syserr) {
+    if err == ENOERR then return;
+    lock$;
+    if error == ENOERR then error = err;
+    lock$ = true;
+  }
+}
 
-  for filename in listdir(path=src, dirs=false, files=true, listlinks=true) {
-    // Take care of files in src
-    var fileDestName = dest + "/" + filename;
-    var fileSrcName = src + "/" + filename;
-    if (isLink(fileSrcName) && copySymbolically) {
-      // Copy symbolically means symlinks should be copied as symlinks
-      symlink(error, realPath(fileSrcName), fileDestName);
-    } else {
-      // Either we didn't find a link, or copy symbolically is false, which
-      // means we want the contents of the linked file, not a link itself.
-      copy(error, fileSrcName, fileDestName, metadata=true);
-    }
-    if (error != ENOERR) then return;
+// Copies the files in src while the subdirectories are copied by other
+// tasks, so reading directories overlaps with copying file contents.
+private proc copyTreeHelper(state: copyTreeState, src: string, dest: string) {
+  use DynamicIters;
+
+  var error: syserr = ENOERR;
+  var oldMode = getMode(error, src);
+  if error == ENOERR then mkdir(error, dest, mode=oldMode, parents=true);
+  if error != ENOERR {
+    state.setError(error);
+    return;
   }
+  // Create dest
 
-  for dirname in listdir(path=src, dirs=true, files=false, listlinks=true) {
-    var dirDestName = dest+"/"+dirname;
-    var dirSrcName = src+"/"+dirname;
-    if (isLink(dirSrcName) && copySymbolically) {
-      // Copy symbolically means symlinks should be copied as symlinks
-      symlink(error, realPath(dirSrcName), dirDestName);
-    } else {
-      // Either we didn't find a link, or copy symbolically is false, which
-      // means we want the contents of the linked directory, not a link itself.
-      copyTreeHelper(error, dirSrcName, dirDestName, copySymbolically);
-    }
-    if (error != ENOERR) then return;
+  var filenames = listdir(path=src, dirs=false, files=true, listlinks=true);
+  var dirnames = listdir(path=src, dirs=true, files=false, listlinks=true);
+
+  cobegin {
+    if filenames.size > 0 then
+      forall i in dynamic(filenames.domain.dim(1), chunkSize=1) {
+        // Take care of files in src
+        var fileDestName = dest + "/" + filenames[i];
+        var fileSrcName = src + "/" + filenames[i];
+        var error: syserr = ENOERR;
+        if state.failed() {
+          // Another task hit an error, don't start any more copies.
+        } else if (isLink(fileSrcName) && state.copySymbolically) {
+          // Copy symbolically means symlinks should be copied as symlinks
+          symlink(error, realPath(fileSrcName), fileDestName);
+        } else {
+          // Either we didn't find a link, or copy symbolically is false, which
+          // means we want the contents of the linked file, not a link itself.
+          copy(error, fileSrcName, fileDestName, metadata=true);
+        }
+        state.setError(error);
+      }
+
+    if dirnames.size > 0 then
+      forall i in dynamic(dirnames.domain.dim(1), chunkSize=1) {
+        var dirDestName = dest + "/" + dirnames[i];
+        var dirSrcName = src + "/" + dirnames[i];
+        var error: syserr = ENOERR;
+        if state.failed() {
+          // Another task hit an error, don't descend any further.
+        } else if (isLink(dirSrcName) && state.copySymbolically) {
+          // Copy symbolically means symlinks should be copied as symlinks
+          symlink(error, realPath(dirSrcName), dirDestName);
+          state.setError(error);
+        } else {
+          // Either we didn't find a link, or copy symbolically is false, which
+          // means we want the contents of the linked directory, not a link
+          // itself.
+          copyTreeHelper(state, dirSrcName, dirDestName);
+        }
+      }
   }
 }
 
@@ -472,7 +488,10 @@ proc copyTree(out error: syserr, src: string, dest: string, copySymbolically: bo
 
   var srcPath = realPath(src);
 
-  copyTreeHelper(error, srcPath, dest, copySymbolically);
+  var state = new copyTreeState(copySymbolically);
+  copyTreeHelper(state, srcPath, dest);
+  error = state.error;
+  delete state;
 }
 
 /* Will recursively copy the tree which lives under `src` into `dst`,
@@ -482,6 +501,10 @@ proc copyTree(out error: syserr, src: string, dest: string, copySymbolically: bo
    copied as symlinks, otherwise their contents and metadata will be copied
    instead.
 
+   Files and subdirectories are copied in parallel, so files may be copied
+   in any order.  If an error occurs, copying stops as soon as the tasks
+   already running finish, and the first error is reported.
+
    Will halt with an error message if one is detected.
 
    :arg src: The root of the source tree to be copied.
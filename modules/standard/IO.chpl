@@ -1659,6 +1659,8 @@ private extern proc qio_file_unlock(f:qio_file_ptr_t);
 private extern proc qio_file_sync(f:qio_file_ptr_t):syserr;
 
 private extern proc qio_channel_end_offset_unlocked(ch:qio_channel_ptr_t):int(64);
+private extern proc qio_channel_get_file(ch:qio_channel_ptr_t):qio_file_ptr_t;
+private extern proc qio_file_isseekable(f:qio_file_ptr_t):bool;
 private extern proc qio_file_get_style(f:qio_file_ptr_t, ref style:iostyle);
 private extern proc qio_file_length(f:qio_file_ptr_t, ref len:int(64)):syserr;
 
@@ -3269,7 +3271,9 @@ proc file.reader(param kind=iokind.dynamic, param locking=true, start:int(64) =
   return ret;
 }
 
-/* Iterate over all of the lines in a file.
+/* Iterate over all of the lines in a file.  The lines can be read in
+   parallel with ``forall line in f.lines()``; see
+   :proc:`ItemReader.these`.
 
    :arg error: optional argument to capture an error code. If this argument
                is not provided and an error is encountered, this function
@@ -4844,6 +4848,41 @@ record ItemReader {
     }
   }
 
+  /* Iterate through the items in parallel, as in
+     ``forall line in f.lines()``.  The rest of the channel's region is
+     split into byte ranges at line boundaries, and each range is read by
+     a separate task using its own unlocked channel, so items must not
+     span lines.  Items are not yielded in order.  Binary channels are
+     read serially.  Afterwards, the channel is at the end of its region.
+   */
+  iter these(param tag: iterKind) where tag == iterKind.standalone {
+    const f = ch._getFile();
+    const start = ch.offset();
+    const end = ch._regionEnd(f);
+    if ch.binary() || end < start {
+      // Binary items can't be found from an arbitrary offset,
+      // and neither can anything in a pipe.
+      for x in these() do yield x;
+    } else {
+      const style = ch._style();
+      const bounds = f._lineBoundaries(start, end,
+                                       _parallelReadChunks(end - start));
+      on ch.home {
+        coforall i in 0..bounds.size-2 {
+          var r = f.reader(kind=kind, locking=false,
+                           start=bounds[i], end=bounds[i+1], style=style);
+          while true {
+            var x:ItemType;
+            if ! r.read(x) then break;
+            yield x;
+          }
+          r.close();
+        }
+      }
+      ch.advance(end - start);
+    }
+  }
+
   /* It would be nice to be able to handle errors
      when reading with these()
      but it's not clear how to get the error argument
@@ -4858,6 +4897,72 @@ record ItemReader {
   }*/
 }
 
+/* Minimum number of bytes read by each task when a channel is read in
+   parallel. */
+private config const _parallelReadMinBytes = 64*1024;
+
+// The number of byte ranges to split len bytes into for a parallel read.
+pragma "no doc"
+proc _parallelReadChunks(len:int(64)):int {
+  const numTasks = if dataParTasksPerLocale==0 then here.maxTaskPar
+                   else dataParTasksPerLocale;
+  return max(1, min(numTasks, len / max(1, _parallelReadMinBytes))):int;
+}
+
+// Returns the file a channel operates on.
+pragma "no doc"
+proc channel._getFile():file {
+  var ret:file;
+  on this.home {
+    var f:file;
+    f._file_internal = qio_channel_get_file(_channel_internal);
+    qio_file_retain(f._file_internal);
+    ret = f;
+  }
+  return ret;
+}
+
+// Returns the offset just past the end of the channel's region,
+// which for a channel without an end is the length of its file.
+// Returns -1 if the file can't be read starting at other offsets.
+pragma "no doc"
+proc channel._regionEnd(f:file):int(64) {
+  var ret:int(64) = -1;
+  on this.home {
+    if qio_file_isseekable(f._file_internal) {
+      ret = qio_channel_end_offset_unlocked(_channel_internal);
+      if ret == max(int(64)) {
+        var len:int(64);
+        if qio_file_length(f._file_internal, len) then ret = -1;
+        else ret = len;
+      }
+    }
+  }
+  return ret;
+}
+
+/* Split start..end-1 into nchunks byte ranges that each start at the
+   beginning of a line.  Returns the ranges as an array of offsets, where
+   range i is ret[i]..ret[i+1]-1; some ranges may be empty.
+ */
+pragma "no doc"
+proc file._lineBoundaries(start:int(64), end:int(64), nchunks:int) {
+  var ret:[0..nchunks] int(64);
+  ret[0] = start;
+  ret[nchunks] = end;
+  forall i in 1..nchunks-1 {
+    const lo = start + ((end - start) * i) / nchunks;
+    // Skip to just after the first newline at or after lo-1
+    var r = this.reader(locking=false, start=lo-1, end=end);
+    var line:string;
+    if r.readline(line) then ret[i] = r.offset();
+    else ret[i] = end;
+    r.close();
+  }
+  for i in 1..nchunks do ret[i] = max(ret[i], ret[i-1]);
+  return ret;
+}
+
 /* Create and return an :record:`ItemReader` that can yield read values of
    a single type.
  */
@@ -450,6 +450,26 @@ module Random {
       else return (numBits(t)+31) / 32;
     }
 
+    // Arrays with at least this many elements are shuffled and permuted by
+    // sorting random keys in parallel rather than with a serial Fisher-Yates
+    // pass.  Changing this changes the result for a given seed.
+    private
+    param PCGRandomPrivate_parShuffleMinSize = 1 << 14;
+
+    // The number of bits needed to store positions 0..n-1
+    private
+    proc PCGRandomPrivate_positionBits(n): int {
+      var bits = 0;
+      while (1: uint(64) << bits) < n: uint(64) do
+        bits += 1;
+      return bits;
+    }
+
+    private
+    proc PCGRandomPrivate_positionMask(n): uint(64) {
+      return (1: uint(64) << PCGRandomPrivate_positionBits(n)) - 1;
+    }
+
     /*
 
       Models a stream of pseudorandom numbers generated by the PCG random number
@@ -706,7 +726,14 @@ module Random {
           x = r;
       }
 
-      /* Randomly shuffle a 1-D array. */
+      /* Randomly shuffle a 1-D array.
+
+         Small arrays are shuffled serially.  Larger ones are shuffled in
+         parallel (across locales, for distributed arrays) by sorting the
+         elements by random keys.  Either way, the result depends only on
+         the seed, the position in the stream and the size of the array,
+         not on the number of tasks or locales used.
+       */
       proc shuffle(arr: [?D] ?eltType ) {
 
         if D.rank != 1 then
@@ -716,6 +743,18 @@ module Random {
               high = D.high,
               stride = D.stride;
 
+        if D.size >= PCGRandomPrivate_parShuffleMinSize {
+          const keys = PCGRandomStreamPrivate_sortedKeys(D),
+                mask = PCGRandomPrivate_positionMask(D.size),
+                src = arr,
+                absStride = abs(stride);
+
+          forall (a, key) in zip(arr, keys) do
+            a = src[low + (key & mask): D.idxType * absStride];
+
+          return;
+        }
+
         if parSafe then
           PCGRandomStreamPrivate_lock$ = true;
 
@@ -753,6 +792,7 @@ module Random {
       /* Produce a random permutation, storing it in a 1-D array.
          The resulting array will include each value from low..high
          exactly once, where low and high refer to the array's domain.
+         Large arrays are permuted in parallel, as in :proc:`shuffle`.
          */
       proc permutation(arr: [] eltType) {
         var low = arr.domain.dim(1).low;
@@ -763,6 +803,16 @@ module Random {
         //if arr.domain.dim(1).stridable then
         //  compilerError("Permutation requires non-stridable 1-D array");
 
+        if arr.domain.size >= PCGRandomPrivate_parShuffleMinSize {
+          const keys = PCGRandomStreamPrivate_sortedKeys(arr.domain),
+                mask = PCGRandomPrivate_positionMask(arr.domain.size);
+
+          forall (a, key) in zip(arr, keys) do
+            a = (low + (key & mask): arr.domain.idxType): eltType;
+
+          return;
+        }
+
         if parSafe then
           PCGRandomStreamPrivate_lock$ = true;
 
@@ -840,6 +890,25 @@ module Random {
       var PCGRandomStreamPrivate_rngs: numGenerators(eltType) * pcg_setseq_64_xsh_rr_32_rng;
       pragma "no doc"
       var PCGRandomStreamPrivate_count: int(64) = 1;
+
+      // Returns one random key per index of the 1-D domain D, sorted.  The
+      // low bits of each key hold the (0-based) position of its index, so
+      // the keys are distinct and masking a sorted key yields the position
+      // of the element that belongs at that spot in a random ordering.
+      pragma "no doc"
+      proc PCGRandomStreamPrivate_sortedKeys(D: domain) {
+        use Sort;
+
+        const n = D.size,
+              posBits = PCGRandomPrivate_positionBits(n);
+
+        var keys: [D] uint(64);
+        forall (key, pos, r) in zip(keys, 0..#n, iterate(D, uint(64))) do
+          key = (r << posBits) | pos: uint(64);
+
+        sort(keys);
+        return keys;
+      }
     }
 
 
@@ -851,6 +920,7 @@ module Random {
     //
 
 
+
     // returns a random number in [0, 1]
     // where the number is a multiple of 2**-64
     private inline
@@ -389,8 +389,51 @@ extern record qio_regexp_string_piece_t {
 private extern proc qio_regexp_string_piece_isnull(ref sp:qio_regexp_string_piece_t):bool;
 
 private extern proc qio_regexp_match(ref re:qio_regexp_t, text:c_string, textlen:int(64), startpos:int(64), endpos:int(64), anchor:c_int, submatch:_ddata(qio_regexp_string_piece_t), nsubmatch:int(64)):bool;
+// For matches that need no capture groups.
+private extern proc qio_regexp_match(ref re:qio_regexp_t, text:c_string, textlen:int(64), startpos:int(64), endpos:int(64), anchor:c_int, ref submatch:qio_regexp_string_piece_t, nsubmatch:int(64)):bool;
 private extern proc qio_regexp_replace(ref re:qio_regexp_t, repl:c_string, repllen:int(64), text:c_string, textlen:int(64), startpos:int(64), endpos:int(64), global:bool, ref replaced:c_string_copy, ref replaced_len:int(64)):int(64);
 
+/* Activity of the cache of compiled regular expressions.  This record
+   type is defined in the same way by both the runtime and this module.
+ */
+extern record qio_regexp_cache_stats_t {
+  /* compilations satisfied by the cache */
+  var hits:int(64);
+  /* compilations that had to compile the pattern */
+  var misses:int(64);
+  /* compiled expressions removed to make room for others */
+  var evictions:int(64);
+  /* compiled expressions currently in the cache */
+  var entries:int(64);
+  /* the most compiled expressions the cache will hold.  This is set
+     with the ``CHPL_RT_REGEXP_CACHE_SIZE`` environment variable, and
+     defaults to 64. */
+  var capacity:int(64);
+}
+
+/* The Chapel record type inherits the runtime definition of it. */
+type regexpCacheStats = qio_regexp_cache_stats_t;
+
+private extern proc qio_regexp_get_cache_stats(ref stats:qio_regexp_cache_stats_t);
+private extern proc qio_regexp_reset_cache_stats();
+
+/*
+   Compiled regular expressions are kept in a cache shared by all of the
+   tasks on a locale, so compiling a pattern that was compiled recently
+   (with the same options) is cheap.  This returns the calling locale's
+   cache counts since the program started or the counts were last reset.
+ */
+proc getRegexpCacheStats():regexpCacheStats {
+  var stats:regexpCacheStats;
+  qio_regexp_get_cache_stats(stats);
+  return stats;
+}
+
+/* Reset the calling locale's regular expression cache counts to zero. */
+proc resetRegexpCacheStats() {
+  qio_regexp_reset_cache_stats();
+}
+
 // These two could be folded together if we had a way
 // to check if a default argument was supplied
 // (or any way to use 'nil' in pass-by-ref)
@@ -564,7 +607,8 @@ proc string.this(m:reMatch) {
 }
 
 /*  This class represents a compiled regular expression. Regular expressions
-    are currently cached on a per-thread basis and are reference counted.
+    are cached on a per-locale basis (see :proc:`getRegexpCacheStats`) and
+    are reference counted.
     To create a compiled regular expression, use the compile function.
 
     A regexp can be cast to a string (resulting in the pattern that
@@ -776,6 +820,59 @@ record regexp {
   }
 
 
+  /*
+     Search each of the passed strings for the first match to this regular
+     expression, as :proc:`regexp.search` would without captures.  This is
+     cheaper than calling :proc:`regexp.search` for each string: the
+     strings are searched in parallel, and without moving to the home
+     locale of this regular expression for each one when they are stored
+     there.
+
+     :arg texts: the strings to search
+     :returns: an array of :record:`reMatch` objects, one for each string
+   */
+  proc searchEach(texts: [?D] string): [D] reMatch {
+    return _matchEach(texts, QIO_REGEXP_ANCHOR_UNANCHORED);
+  }
+
+  /*
+     Check each of the passed strings for a match to this regular
+     expression at its start, as :proc:`regexp.match` would without
+     captures.  Like :proc:`regexp.searchEach`, this handles the strings
+     in parallel.
+
+     :arg texts: the strings to check
+     :returns: an array of :record:`reMatch` objects, one for each string
+   */
+  proc matchEach(texts: [?D] string): [D] reMatch {
+    return _matchEach(texts, QIO_REGEXP_ANCHOR_START);
+  }
+
+  pragma "no doc"
+  proc _matchEach(texts: [?D] string, anchor: c_int): [D] reMatch {
+    var ret: [D] reMatch;
+    on this.home {
+      const homeId = here.id;
+      forall (r, text) in zip(ret, texts) {
+        if here.id == homeId {
+          const localText = text.localize();
+          var m: qio_regexp_string_piece_t;
+          const got = qio_regexp_match(_regexp, localText.c_str(),
+                                       localText.length, 0, localText.length,
+                                       anchor, m, 1);
+          r = if got then _to_reMatch(m) else new reMatch(false, -1, 0);
+        } else {
+          // a distributed array put this element on another locale
+          if anchor == QIO_REGEXP_ANCHOR_START then
+            r = this.match(text);
+          else
+            r = this.search(text);
+        }
+      }
+    }
+    return ret;
+  }
+
   /*
      Split the text by occurrences of this regular expression.
      If capturing parentheses are used in pattern, then the text of all
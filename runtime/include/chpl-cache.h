@@ -25,6 +25,32 @@
 #include "chpl-comm.h" // to get HAS_CHPL_CACHE_FNS via chpl-comm-task-decls.h
 #include "chpl-tasks.h"
 
+//
+// Cache diagnostics stuff
+//
+// Counts of remote data cache events on this locale.  These are only
+// collected between chpl_startCacheDiagnosticsHere() and
+// chpl_stopCacheDiagnosticsHere(), and are always zero when the cache
+// is not available or not enabled.
+//
+typedef struct _chpl_cacheDiagnostics {
+  uint64_t get_hits;              // page fully satisfied from the cache
+  uint64_t get_partial_hits;      // page cached but some lines fetched
+  uint64_t get_misses;            // page not cached
+  uint64_t readahead_issued;      // sequential readahead windows started
+  uint64_t readahead_used;        // readahead windows reached by a GET
+  uint64_t prefetches;            // explicit prefetch requests
+  uint64_t dirty_flushes;         // PUTs started to write back dirty data
+  uint64_t ain_evictions;         // pages evicted from the Ain queue
+  uint64_t am_evictions;          // pages evicted from the Am queue
+  uint64_t acquire_invalidations; // cached pages refetched after an acquire
+} chpl_cacheDiagnostics;
+
+void chpl_startCacheDiagnosticsHere(void);
+void chpl_stopCacheDiagnosticsHere(void);
+void chpl_resetCacheDiagnosticsHere(void);
+void chpl_getCacheDiagnosticsHere(chpl_cacheDiagnostics *cd);
+
 #ifdef HAS_CHPL_CACHE_FNS
 // This is a cache for remote data.
 
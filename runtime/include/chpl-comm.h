@@ -391,6 +391,39 @@ void chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
                          chpl_fn_int_t fid,
                          chpl_comm_on_bundle_t *arg, size_t arg_size);
 
+//
+// Aggregated remote updates.
+//
+// An aggregator collects small PUTs and remote 64-bit integer additions
+// bound for each locale in a per-locale buffer, and sends each buffer
+// as a single message when it fills.  The destination applies the
+// updates in the order they appear in the message.  Updates are only
+// guaranteed to be visible at their destinations once
+// chpl_comm_agg_flush() or chpl_comm_agg_destroy() returns, and updates
+// to the same address that are sent in different messages are not
+// ordered with respect to each other.  An aggregator may only be used
+// by one task at a time, on the locale that created it.
+//
+void* chpl_comm_agg_create(void);
+void chpl_comm_agg_put(void* agg, c_nodeid_t node, void* raddr,
+                       void* addr, size_t size);
+void chpl_comm_agg_add_int64(void* agg, c_nodeid_t node, void* raddr,
+                             int64_t val);
+void chpl_comm_agg_flush(void* agg);
+void chpl_comm_agg_destroy(void* agg);
+
+//
+// These are implemented by the comm layers in support of the above.
+// chpl_comm_agg_send() sends 'size' bytes of aggregated updates at
+// 'buf' to 'node'; 'buf' may be reused as soon as it returns.  Once the
+// updates have been applied (using chpl_comm_agg_apply() on 'node'),
+// the comm layer must call chpl_comm_agg_ack(ack) on this locale.
+//
+size_t chpl_comm_agg_max_msg_size(void);
+void chpl_comm_agg_send(c_nodeid_t node, void* buf, size_t size, void* ack);
+void chpl_comm_agg_apply(void* buf, size_t size);
+void chpl_comm_agg_ack(void* ack);
+
 
 //
 // This call specifies the number of polling tasks that the
@@ -441,6 +474,45 @@ void chpl_gen_stopCommDiagnosticsHere(void);
 void chpl_resetCommDiagnosticsHere(void);
 void chpl_getCommDiagnosticsHere(chpl_commDiagnostics *cd);
 
+//
+// Detailed comm diagnostics.  While counting is on, the comm layers
+// also record, for each kind of operation below, how many were sent to
+// each locale and a histogram of their sizes in bytes.  For blocking
+// operations they record a histogram of the latencies, in nanoseconds,
+// as well.  Histogram bucket 0 counts the values less than 2, and
+// bucket i > 0 counts the values in [2**i, 2**(i+1)), except that the
+// last bucket also counts everything larger.  The storage for this is
+// shared code in chpl-comm.c; the comm layers only report the events.
+//
+typedef enum {
+  chpl_comm_diags_get,
+  chpl_comm_diags_get_nb,
+  chpl_comm_diags_put,
+  chpl_comm_diags_put_nb,
+  chpl_comm_diags_execute_on,
+  chpl_comm_diags_execute_on_fast,
+  chpl_comm_diags_execute_on_nb,
+  chpl_comm_diags_num_ops
+} chpl_comm_diags_op_t;
+
+#define CHPL_COMM_DIAGS_NUM_BUCKETS 32
+
+void chpl_comm_diags_init(void);   // call from chpl_comm_post_mem_init()
+void chpl_comm_diags_reset(void);
+
+// Record an operation of 'size' bytes sent to 'node'.
+void chpl_comm_diags_count(chpl_comm_diags_op_t op, c_nodeid_t node,
+                           size_t size);
+
+// Record the latency of a blocking operation that began when
+// chpl_comm_diags_time() returned 'start'.
+uint64_t chpl_comm_diags_time(void);
+void chpl_comm_diags_latency(chpl_comm_diags_op_t op, uint64_t start);
+
+void chpl_getCommSizeHistogramHere(int32_t op, uint64_t* buckets);
+void chpl_getCommLatencyHistogramHere(int32_t op, uint64_t* buckets);
+void chpl_getCommDestCountsHere(int32_t op, uint64_t* counts);
+
 #else // LAUNCHER
 
 #define chpl_comm_barrier(x)
@@ -34,6 +34,10 @@ qioerr chpl_fs_chmod(const char* name, int mode);
 
 qioerr chpl_fs_chown(const char* name, int uid, int gid);
 
+// Copies the contents of source into dest, creating or truncating dest.
+// The copy is done in the kernel when the OS supports it.
+qioerr chpl_fs_copy_file(const char* source, const char* dest);
+
 qioerr chpl_fs_copy_metadata(const char* source, const char* dest);
 
 qioerr chpl_fs_cwd(const char** working_dir);
@@ -23,12 +23,33 @@
 #include <stdint.h>
 #include "chpltypes.h"
 
+//
+// The table of privatized objects is a fixed directory of fixed-size chunks,
+// see chpl-privatization.c.  This bounds the number of live privatized
+// objects to CHPL_PRIVATIZATION_DIR_SIZE * CHPL_PRIVATIZATION_CHUNK_SIZE.
+//
+#define CHPL_PRIVATIZATION_CHUNK_LOG2 10
+#define CHPL_PRIVATIZATION_CHUNK_SIZE (INT64_C(1) << CHPL_PRIVATIZATION_CHUNK_LOG2)
+#define CHPL_PRIVATIZATION_CHUNK_MASK (CHPL_PRIVATIZATION_CHUNK_SIZE - 1)
+#define CHPL_PRIVATIZATION_DIR_SIZE (INT64_C(1) << 16)
+
+extern void* chpl_privateObjects[CHPL_PRIVATIZATION_DIR_SIZE];
+
 void chpl_privatization_init(void);
 
+// Only called on locale 0
+int64_t chpl_reservePrivatizedPid(void);
+void chpl_releasePrivatizedPid(int64_t);
+
 void chpl_newPrivatizedClass(void*, int64_t);
-void* chpl_getPrivatizedClass(int64_t);
 void chpl_clearPrivatizedClass(int64_t);
 
+static inline
+void* chpl_getPrivatizedClass(int64_t i) {
+  void** chunk = chpl_privateObjects[i >> CHPL_PRIVATIZATION_CHUNK_LOG2];
+  return chunk[i & CHPL_PRIVATIZATION_CHUNK_MASK];
+}
+
 int64_t chpl_numPrivatizedClasses(void);
 
 #endif // LAUNCHER
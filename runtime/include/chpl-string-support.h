@@ -88,4 +88,18 @@ c_string_copy string_index(c_string x, int i, int32_t lineno, int32_t filename);
 // TODO: A separate unstrided version could return a c_string instead.
 c_string_copy string_select(c_string x, int low, int high, int stride, int32_t lineno, int32_t filename);
 
+//
+// Substring search over byte buffers with explicit lengths, so the
+// haystack need not be NUL-terminated and may be part of a larger string.
+// find and rfind return the 0-based offset of the first (last) occurrence
+// of the needle, or -1 if there is none.  count returns the number of
+// (possibly overlapping) occurrences.  The needle must not be empty.
+//
+int64_t chpl_string_find(const void* haystack, int64_t hlen,
+                         const void* needle, int64_t nlen);
+int64_t chpl_string_rfind(const void* haystack, int64_t hlen,
+                          const void* needle, int64_t nlen);
+int64_t chpl_string_count(const void* haystack, int64_t hlen,
+                          const void* needle, int64_t nlen);
+
 #endif
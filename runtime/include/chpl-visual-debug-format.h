@@ -0,0 +1,150 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Visual Debug binary data file format
+//
+// This file is shared by the runtime (runtime/src/chpl-visual-debug.c),
+// which writes the files, and chplvis (tools/chplvis/DataModel.cxx),
+// which reads them.  It must stay free of any other runtime includes.
+//
+// A binary data file is a chpl_vdebug_header_t followed by a sequence
+// of fixed size chpl_vdebug_rec_t records.  String records (file names,
+// function names, tag names, ...) are followed by the bytes of the
+// string, NUL terminated and padded out to a whole number of records.
+// Unlike the text format, the addresses of puts, gets and forks are not
+// recorded since chplvis does not use them.
+//
+// Event records are buffered per thread, so within a file they are only
+// ordered by time between the "barrier" records (tag, pause and end),
+// which are written after all buffers on the node have been flushed.
+//
+
+#ifndef _chpl_visual_debug_format_h_
+#define _chpl_visual_debug_format_h_
+
+#include <stdint.h>
+
+#define CHPL_VDEBUG_MAGIC       "ChplVdbB"
+#define CHPL_VDEBUG_MAGIC_LEN   8
+#define CHPL_VDEBUG_BYTE_ORDER  0x01020304
+#define CHPL_VDEBUG_VER_MAJOR   1
+#define CHPL_VDEBUG_VER_MINOR   2
+
+// All times are in microseconds.
+typedef struct {
+  char    magic[CHPL_VDEBUG_MAGIC_LEN];  // CHPL_VDEBUG_MAGIC, no NUL
+  int32_t byteOrder;                     // CHPL_VDEBUG_BYTE_ORDER
+  int16_t verMajor;
+  int16_t verMinor;
+  int32_t recSize;                       // sizeof(chpl_vdebug_rec_t)
+  int32_t nodes;                         // number of nodes in the run
+  int32_t nid;                           // node that wrote this file
+  int32_t pad;
+  int64_t tid;                           // task that started the logging
+  double  seq;                           // same for all files of a run
+  int64_t time;                          // time of day at start
+  int64_t utime;                         // user time at start
+  int64_t stime;                         // system time at start
+} chpl_vdebug_header_t;
+
+typedef enum {
+  chpl_vdebug_rec_none = 0,
+
+  // Tables, only in the file for node 0 (and tname in any file)
+  chpl_vdebug_rec_tables,      // sizes of the file name and function tables
+  chpl_vdebug_rec_chpl_home,   // string: CHPL_HOME at run time
+  chpl_vdebug_rec_dir,         // string: compilation directory
+  chpl_vdebug_rec_fname,       // string: file name table entry
+  chpl_vdebug_rec_fidname,     // string: function name table entry
+  chpl_vdebug_rec_tname,       // string: tag name
+
+  // Barrier records
+  chpl_vdebug_rec_tag,
+  chpl_vdebug_rec_pause,
+  chpl_vdebug_rec_end,
+
+  // Event records
+  chpl_vdebug_rec_mark,        // tid is a xxxVdebug() task
+  chpl_vdebug_rec_task,        // task created
+  chpl_vdebug_rec_btask,       // task began
+  chpl_vdebug_rec_etask,       // task ended
+  chpl_vdebug_rec_put,
+  chpl_vdebug_rec_get,
+  chpl_vdebug_rec_put_nb,
+  chpl_vdebug_rec_get_nb,
+  chpl_vdebug_rec_put_strd,
+  chpl_vdebug_rec_get_strd,
+  chpl_vdebug_rec_fork,
+  chpl_vdebug_rec_fork_nb,
+  chpl_vdebug_rec_fork_fast,
+
+  chpl_vdebug_rec_num_kinds
+} chpl_vdebug_rec_kind_t;
+
+typedef struct {
+  int32_t kind;                 // chpl_vdebug_rec_kind_t
+  int32_t nid;                  // node logging the record
+  int64_t time;                 // time of day of the event
+  int64_t tid;                  // task logging the event, the new task
+                                //   for task records
+  union {
+    struct {                    // put, get and their _nb and _strd forms
+      int64_t size;             // bytes transferred
+      int32_t rnid;             // remote node
+      int32_t typeIndex;
+      int32_t lineno;
+      int32_t fileno;
+    } comm;
+    struct {                    // fork, fork_nb, fork_fast
+      int64_t argSize;
+      int32_t rnid;             // node the fork runs on
+      int32_t subloc;
+      int32_t fid;
+    } fork;
+    struct {                    // task, btask, etask
+      int64_t ptid;             // parent task (task records only)
+      int32_t isOn;             // started by an executeOn
+      int32_t lineno;
+      int32_t fileno;
+      int32_t fid;
+    } task;
+    struct {                    // tag, pause, end
+      int64_t utime;
+      int64_t stime;
+      int32_t tagno;
+    } times;
+    struct {                    // chpl_home, dir, fname, fidname, tname
+      int32_t ix;               // table index or tag number
+      int32_t lineno;           // fidname only
+      int32_t fileno;           // fidname only
+      int32_t len;              // length of the string, without the NUL
+    } str;
+    struct {
+      int32_t fileTblSize;
+      int32_t funcTblSize;
+    } tables;
+  } u;
+} chpl_vdebug_rec_t;
+
+// Number of records holding a string of length len, including its NUL.
+#define CHPL_VDEBUG_STR_RECS(len) \
+  (((len) + sizeof(chpl_vdebug_rec_t)) / sizeof(chpl_vdebug_rec_t))
+
+#endif
@@ -636,6 +636,13 @@ void qio_file_get_style(qio_file_t* f, qio_style_t* style)
   *style = f->style;
 }
 
+// Returns true if channels on this file can start at any offset.
+static inline
+qio_bool qio_file_isseekable(qio_file_t* f)
+{
+  return (f->fdflags & QIO_FDFLAG_SEEKABLE) != 0;
+}
+
 // Return the current length of a file.
 // Calls stat for a file descriptor
 // Calls fflush on a FILE* first.
@@ -77,6 +77,20 @@ int64_t qio_regexp_get_ncaptures(const qio_regexp_t* regexp);
 qio_bool qio_regexp_ok(const qio_regexp_t* regexp);
 const char* qio_regexp_error(const qio_regexp_t* regexp);
 
+// Compiled regular expressions are kept in a cache shared by all of the
+// threads on a locale.  These count its activity since program start (or
+// the last reset) and report how full it is.
+typedef struct qio_regexp_cache_stats_s {
+  int64_t hits;
+  int64_t misses;
+  int64_t evictions;
+  int64_t entries;
+  int64_t capacity;
+} qio_regexp_cache_stats_t;
+
+void qio_regexp_get_cache_stats(qio_regexp_cache_stats_t* stats);
+void qio_regexp_reset_cache_stats(void);
+
 enum {
   QIO_REGEXP_ANCHOR_UNANCHORED = 0,
   QIO_REGEXP_ANCHOR_START,
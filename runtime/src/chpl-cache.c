@@ -282,6 +282,8 @@ use.
 #include "chpl-linefile-support.h"
 #include "sys.h" // sys_page_size()
 #include "chpl-comm-no-warning-macros.h" // No warnings for chpl_comm_get etc.
+#include "chpl-env.h" // chpl_get_rt_env
+#include "error.h" // chpl_warning
 #include <string.h> // memcpy, memset, etc.
 #include <assert.h>
 
@@ -300,7 +302,10 @@ use.
 #define MAX_CACHE_DATA_SIZE (256*1024*1024)
 
 // How many pending operations can we have at once?
-#define MAX_PENDING 32
+// (default; CHPL_RT_CACHE_MAX_PENDING can change it and it must be
+//  a power of 2)
+#define DEFAULT_MAX_PENDING 32
+static int cache_max_pending = DEFAULT_MAX_PENDING;
 
 // CACHEPAGE_BITS 
 // Controls the cache page size - the cache manages items of this many bytes
@@ -309,8 +314,14 @@ use.
 // Reasonable values for CACHEPAGE_BITS are between 6 and 12
 // (64 bytes and 4k bytes. CACHEPAGE_BITS should not be larger than the
 // page size) and it must currently be even.
-// Here we set it to 1k bytes (ie 2^10).
-#define CACHEPAGE_BITS 10
+// By default we set it to 1k bytes (ie 2^10). It can be changed at
+// program start with CHPL_RT_CACHE_PAGE_SIZE; data structures that
+// hold per-page bitmasks are sized for MAX_CACHEPAGE_BITS.
+#define DEFAULT_CACHEPAGE_BITS 10
+#define MIN_CACHEPAGE_BITS 6
+#define MAX_CACHEPAGE_BITS 12
+static int cache_page_bits = DEFAULT_CACHEPAGE_BITS;
+#define CACHEPAGE_BITS cache_page_bits
 #define CACHEPAGE_SIZE (1 << CACHEPAGE_BITS)
 #define CACHEPAGE_MASK (CACHEPAGE_SIZE-1)
 
@@ -319,27 +330,64 @@ use.
 // that are fetched for any 'get' operation.
 //
 // Reasonable values for CACHELINE_BITS are between 6 and CACHEPAGE_BITS.
-// Here we set it to 64 bytes (ie 2^6)
-#define CACHELINE_BITS 6
+// By default we set it to 64 bytes (ie 2^6). It can be changed at
+// program start with CHPL_RT_CACHE_LINE_SIZE.
+#define DEFAULT_CACHELINE_BITS 6
+#define MIN_CACHELINE_BITS 6
+static int cache_line_bits = DEFAULT_CACHELINE_BITS;
+#define CACHELINE_BITS cache_line_bits
 #define CACHELINE_SIZE (1 << CACHELINE_BITS)
 #define CACHELINE_MASK (CACHELINE_SIZE-1)
 
 // What type can store the number of cache lines in a cache page?
 typedef int8_t line_per_page_t; 
-// What type for a number of lines to read ahead?
-typedef int16_t readahead_distance_t;
+// What type for a number of bytes to read ahead?
+// This must be able to store MAX_ADAPTIVE_READAHEAD_PAGES*CACHEPAGE_SIZE.
+typedef int32_t readahead_distance_t;
 
 // When prefetching, what is the maximum number of pages
 // we are willing to prefetch? This is also the maximum
 // readahead window size for sequential access.
-#define MAX_PAGES_PER_PREFETCH 2
+// (default; CHPL_RT_CACHE_READAHEAD_PAGES can change it)
+#define DEFAULT_PAGES_PER_PREFETCH 2
+static int cache_pages_per_prefetch = DEFAULT_PAGES_PER_PREFETCH;
+
+// Should the readahead window grow beyond cache_pages_per_prefetch
+// for long sequential streams? (CHPL_RT_CACHE_ADAPTIVE_READAHEAD)
+// If so, each readahead trigger that finds the window already at its
+// limit doubles the limit, up to MAX_ADAPTIVE_READAHEAD_PAGES (and no
+// more than a quarter of the Ain queue); a congested cache halves it.
+static chpl_bool cache_adaptive_readahead = false;
+#define MAX_ADAPTIVE_READAHEAD_PAGES 64
 
 // Should we enable sequential readahead?
 // For sequential access If we're reading  
 #define ENABLE_READAHEAD 1
 #define ENABLE_READAHEAD_TRIGGER_WITHIN_PAGE 1
 #define ENABLE_READAHEAD_TRIGGER_SEQUENTIAL 0
-#define MAX_SEQUENTIAL_READAHEAD_BYTES (MAX_PAGES_PER_PREFETCH*CACHEPAGE_SIZE)
+
+// Cache diagnostics (see chpl_cacheDiagnostics in chpl-cache.h).
+// These are shared by all of the per-thread caches on a locale and
+// are only updated while chpl_cache_diagnostics is set.
+static int chpl_cache_diagnostics = 0;
+static struct {
+  atomic_uint_least64_t get_hits;
+  atomic_uint_least64_t get_partial_hits;
+  atomic_uint_least64_t get_misses;
+  atomic_uint_least64_t readahead_issued;
+  atomic_uint_least64_t readahead_used;
+  atomic_uint_least64_t prefetches;
+  atomic_uint_least64_t dirty_flushes;
+  atomic_uint_least64_t ain_evictions;
+  atomic_uint_least64_t am_evictions;
+  atomic_uint_least64_t acquire_invalidations;
+} cache_diags;
+
+#define CACHE_DIAG_INC(field) \
+  do { \
+    if( chpl_cache_diagnostics ) \
+      atomic_fetch_add_uint_least64_t(&cache_diags.field, 1); \
+  } while(0)
 
 //#define TIME
 //#define TRACE
@@ -442,6 +490,7 @@ struct rdcache_s;
 // How many uint64_t words do we need to create a bitmask for CACHEPAGE_SIZE?
 // Divide # bytes in cache by 64, rounding up.
 #define CACHEPAGE_BITMASK_WORDS ((CACHEPAGE_SIZE+63)/64)
+#define MAX_CACHEPAGE_BITMASK_WORDS (((1 << MAX_CACHEPAGE_BITS)+63)/64)
 
 // How many cache lines per cache page?
 #define CACHE_LINES_PER_PAGE (CACHEPAGE_SIZE/CACHELINE_SIZE)
@@ -449,6 +498,8 @@ struct rdcache_s;
 // How many uint64_t words do we need to create a bitmask for CACHE_LINES_PER_PAGE
 // ie, a mask recording a bit per cache line?
 #define CACHE_LINES_PER_PAGE_BITMASK_WORDS (((CACHEPAGE_SIZE/CACHELINE_SIZE)+63)/64)
+#define MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS \
+  ((((1 << MAX_CACHEPAGE_BITS) >> MIN_CACHELINE_BITS)+63)/64)
 
 struct cache_entry_base_s {
   uint32_t index_bits;
@@ -471,7 +522,7 @@ struct dirty_entry_s {
   // which cache entry are we talking about here?
   struct cache_entry_s* entry;
   // Which of the page's bytes are dirty?
-  uint64_t dirty[CACHEPAGE_BITMASK_WORDS]; // ie we need to create a put for these bytes
+  uint64_t dirty[MAX_CACHEPAGE_BITMASK_WORDS]; // ie we need to create a put for these bytes
 };
 
 #define QUEUE_FREE 0
@@ -508,7 +559,7 @@ struct cache_entry_s {
   // This refers to CACHEPAGE_SIZE bytes of memory.
   unsigned char* page;
   // Which of the cache lines have we done 'get's for?
-  uint64_t valid_lines[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  uint64_t valid_lines[MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   // dirty info if this cache page is dirty, NULL otherwise.
   struct dirty_entry_s* dirty;
   // What is the minimum sequence number stored in this cache entry?
@@ -547,7 +598,7 @@ static int set_valid_lines(uint64_t* valid, uintptr_t skip, uintptr_t len)
 // Note skip/len are in line numbers, NOT byte offsets!
 static void unset_valid_lines(uint64_t* valid, uintptr_t skip, uintptr_t len)
 {
-  uint64_t myvalid[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  uint64_t myvalid[MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   unset_valids_for_skip_len(valid, myvalid, skip, len, CACHE_LINES_PER_PAGE_BITMASK_WORDS);  
 }
 /*
@@ -584,6 +635,11 @@ struct rdcache_s {
   c_nodeid_t last_cache_miss_read_node;
   raddr_t last_cache_miss_read_addr;
 
+  // The current limit, in pages, on a prefetch or a sequential
+  // readahead window. This is cache_pages_per_prefetch unless adaptive
+  // readahead has grown it.
+  int readahead_max_pages;
+
   // The variable names Ain Aout and Am come from the 2Q paper
 
   // Ain is a FIFO queue storing entries initially as they go into
@@ -689,7 +745,7 @@ struct rdcache_s* cache_create(void) {
 
   size_t total_size = 0;
   size_t allocated_size = 0;
-  unsigned int pending_len = MAX_PENDING; 
+  unsigned int pending_len = cache_max_pending;
   unsigned char* buffer;
   unsigned char* pages;
 
@@ -766,6 +822,8 @@ struct rdcache_s* cache_create(void) {
   c->last_cache_miss_read_node = -1;
   c->last_cache_miss_read_addr = 0;
 
+  c->readahead_max_pages = cache_pages_per_prefetch;
+
   c->max_pages = cache_pages;
   c->max_entries = n_entries;
   c->max_top_nodes = top_entries;
@@ -828,7 +886,7 @@ struct rdcache_s* cache_create(void) {
   }
   c->dirty_lru_tail = &dirty_nodes[dirty_pages-1];
 
-  c->pending_len = MAX_PENDING;
+  c->pending_len = pending_len;
   c->pending_first_entry = -1;
   c->pending_last_entry = -1;
   // already set c->pending to allocated region
@@ -1168,6 +1226,8 @@ void ain_evict(struct rdcache_s* cache, struct cache_entry_s* dont_evict_me)
   // of Ain in any way (or reuse the associated page).
   flush_entry(cache, y, FLUSH_EVICT, 0, CACHEPAGE_SIZE);
 
+  CACHE_DIAG_INC(ain_evictions);
+
   DOUBLE_REMOVE_TAIL(cache, ain);
   cache->ain_current--;
 
@@ -1206,6 +1266,8 @@ void am_evict(struct rdcache_s *cache, struct cache_entry_s* dont_evict_me) {
   // of Ain in any way (or reuse the associated page).
   flush_entry(cache, y, FLUSH_EVICT, 0, CACHEPAGE_SIZE);
 
+  CACHE_DIAG_INC(am_evictions);
+
   DOUBLE_REMOVE_TAIL(cache, am_lru);
   cache->am_current--;
 
@@ -1742,6 +1804,8 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
           // Save the handle in the list of pending requests.
           entry->max_put_sequence_number = pending_push(cache, handle);
 
+          CACHE_DIAG_INC(dirty_flushes);
+
           // Move past this region of 1s in dirty bits.
           start = got_skip + got_len;
         }
@@ -2091,6 +2155,33 @@ void cache_get(struct rdcache_s* cache,
                 int sequential_readahead_length,
                 int ln, int32_t fn);
 
+// Adaptive readahead: called when a readahead trigger of len bytes
+// fires. A trigger that fires while the window is already at its limit
+// means a sequential stream is consuming data as fast as we fetch it,
+// so let the window grow. If the cache is congested, shrink it instead.
+static
+void adapt_readahead_window(struct rdcache_s* cache, readahead_distance_t len)
+{
+  int max_pages = MAX_ADAPTIVE_READAHEAD_PAGES;
+
+  // Don't let a readahead window push its own pages out of Ain.
+  if( max_pages > (int) cache->ain_max / 4 )
+    max_pages = cache->ain_max / 4;
+  if( max_pages < cache_pages_per_prefetch )
+    max_pages = cache_pages_per_prefetch;
+
+  if( is_congested(cache) ) {
+    if( cache->readahead_max_pages / 2 >= cache_pages_per_prefetch )
+      cache->readahead_max_pages /= 2;
+  } else if( len >= cache->readahead_max_pages * CACHEPAGE_SIZE ) {
+    if( 2 * cache->readahead_max_pages <= max_pages )
+      cache->readahead_max_pages *= 2;
+  }
+
+  INFO_PRINT(("%i adaptive readahead window now %i pages\n",
+              (int) chpl_nodeID, cache->readahead_max_pages));
+}
+
 static
 void cache_get_trigger_readahead(struct rdcache_s* cache,
                                  c_nodeid_t node,
@@ -2111,6 +2202,8 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
 
   if( len == 0 ) return;
 
+  CACHE_DIAG_INC(readahead_used);
+
   INFO_PRINT(("%i trigger readahead(%i, %p, %p, %i, %i, %i, %i)\n",
               (int) chpl_nodeID, (int) node,
               (void*) page_raddr, (void*) request_raddr,
@@ -2119,11 +2212,15 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
 
   // If we are accessing a page that has a readahead condition,
   // trigger that readahead.
+  if( ENABLE_READAHEAD && skip && cache_adaptive_readahead ) {
+    adapt_readahead_window(cache, len);
+  }
+
   if( ENABLE_READAHEAD && skip && ! is_congested(cache) ) {
     next_ra_length = 2 * len;
 
-    if( next_ra_length > MAX_SEQUENTIAL_READAHEAD_BYTES )
-      next_ra_length = MAX_SEQUENTIAL_READAHEAD_BYTES;
+    if( next_ra_length > cache->readahead_max_pages * CACHEPAGE_SIZE )
+      next_ra_length = cache->readahead_max_pages * CACHEPAGE_SIZE;
 
     if( skip < 0 )
       next_ra_length = - next_ra_length;
@@ -2177,6 +2274,7 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
     if( ok && prefetch_start < prefetch_end ) {
       INFO_PRINT(("%i starting readahead from %p to %p\n",
                   (int) chpl_nodeID, (void*) (prefetch_start), (void*) (prefetch_end)));
+      CACHE_DIAG_INC(readahead_issued);
       cache_get(cache, NULL /* prefetch */,
                 node,
                 prefetch_start, prefetch_end - prefetch_start,
@@ -2277,8 +2375,8 @@ void cache_get(struct rdcache_s* cache,
 
   // If the request is too large to reasonably fit in the cache, limit
   // the amount of data prefetched. (or do nothing?)
-  if( isprefetch && (ra_last_page-ra_first_page)/CACHEPAGE_SIZE+1 > MAX_PAGES_PER_PREFETCH ) {
-    ra_last_page = ra_first_page + CACHEPAGE_SIZE*MAX_PAGES_PER_PREFETCH;
+  if( isprefetch && (ra_last_page-ra_first_page)/CACHEPAGE_SIZE+1 > cache->readahead_max_pages ) {
+    ra_last_page = ra_first_page + CACHEPAGE_SIZE*cache->readahead_max_pages;
   }
 
   // Try to find it in the cache. Go through one page at a time.
@@ -2404,6 +2502,7 @@ void cache_get(struct rdcache_s* cache,
         // If the cache line is in Am, move it to the front of Am.
         use_entry(cache, entry);
         if( ! isprefetch ) {
+          CACHE_DIAG_INC(get_hits);
       
           //printf("cache hit on page %i:%p %p ra_len %i\n", 
           //       node, (void*) ra_page, (void*) requested_start,
@@ -2455,6 +2554,12 @@ void cache_get(struct rdcache_s* cache,
 
     // Otherwise -- start a get !
 
+    if( ! isprefetch ) {
+      if( entry && entry_after_acquire ) CACHE_DIAG_INC(get_partial_hits);
+      else CACHE_DIAG_INC(get_misses);
+    }
+    if( entry && ! entry_after_acquire ) CACHE_DIAG_INC(acquire_invalidations);
+
     if( ! page ) {
       // get a page from the free list.
       page = allocate_page(cache);
@@ -2721,10 +2826,100 @@ void chpl_cache_do_init(void)
   }
 }
 
+// Read an integer CHPL_RT_CACHE_* setting. Returns dflt if the
+// variable is not set, or (with a warning) if it is not a power of 2
+// in [min,max].
+static
+int get_cache_env_pow2(const char* ev, int dflt, int min, int max)
+{
+  const char* p;
+  char msg[200];
+  int val;
+
+  if ((p = chpl_get_rt_env(ev, NULL)) == NULL)
+    return dflt;
+
+  if (sscanf(p, "%i", &val) != 1 ||
+      val < min || val > max || (val & (val-1)) != 0) {
+    snprintf(msg, sizeof(msg),
+             "CHPL_RT_%s must be a power of 2 between %i and %i; using %i",
+             ev, min, max, dflt);
+    chpl_warning(msg, 0, 0);
+    return dflt;
+  }
+
+  return val;
+}
+
+static
+int log2_pow2(int val)
+{
+  int bits = 0;
+  while( (1 << bits) < val ) bits++;
+  return bits;
+}
+
+// Set up the cache geometry and readahead policy from the environment.
+// This must happen before any cache is created.
+static
+void chpl_cache_read_config(void)
+{
+  int page_size, line_size;
+  char msg[200];
+
+  page_size = get_cache_env_pow2("CACHE_PAGE_SIZE",
+                                 1 << DEFAULT_CACHEPAGE_BITS,
+                                 1 << MIN_CACHEPAGE_BITS,
+                                 1 << MAX_CACHEPAGE_BITS);
+  // The address hashing splits the remaining bits into two halves.
+  if( log2_pow2(page_size) % 2 != 0 ) {
+    snprintf(msg, sizeof(msg),
+             "CHPL_RT_CACHE_PAGE_SIZE must be 64, 256, 1024 or 4096; "
+             "using %i", 1 << DEFAULT_CACHEPAGE_BITS);
+    chpl_warning(msg, 0, 0);
+    page_size = 1 << DEFAULT_CACHEPAGE_BITS;
+  }
+  if( (size_t) page_size > sys_page_size() )
+    page_size = 1 << DEFAULT_CACHEPAGE_BITS;
+  cache_page_bits = log2_pow2(page_size);
+
+  line_size = get_cache_env_pow2("CACHE_LINE_SIZE",
+                                 1 << DEFAULT_CACHELINE_BITS,
+                                 1 << MIN_CACHELINE_BITS,
+                                 page_size);
+  cache_line_bits = log2_pow2(line_size);
+
+  cache_pages_per_prefetch =
+    get_cache_env_pow2("CACHE_READAHEAD_PAGES", DEFAULT_PAGES_PER_PREFETCH,
+                       1, MAX_ADAPTIVE_READAHEAD_PAGES);
+
+  cache_max_pending =
+    get_cache_env_pow2("CACHE_MAX_PENDING", DEFAULT_MAX_PENDING, 1, 1024);
+
+  cache_adaptive_readahead =
+    chpl_get_rt_env_bool("CACHE_ADAPTIVE_READAHEAD", false);
+}
+
+static
+void init_cache_diagnostics(void) {
+  atomic_init_uint_least64_t(&cache_diags.get_hits, 0);
+  atomic_init_uint_least64_t(&cache_diags.get_partial_hits, 0);
+  atomic_init_uint_least64_t(&cache_diags.get_misses, 0);
+  atomic_init_uint_least64_t(&cache_diags.readahead_issued, 0);
+  atomic_init_uint_least64_t(&cache_diags.readahead_used, 0);
+  atomic_init_uint_least64_t(&cache_diags.prefetches, 0);
+  atomic_init_uint_least64_t(&cache_diags.dirty_flushes, 0);
+  atomic_init_uint_least64_t(&cache_diags.ain_evictions, 0);
+  atomic_init_uint_least64_t(&cache_diags.am_evictions, 0);
+  atomic_init_uint_least64_t(&cache_diags.acquire_invalidations, 0);
+}
+
 // The implementation of functions in chpl-cache.h
 
 void chpl_cache_init(void) {
 
+  init_cache_diagnostics();
+
   // Take default CHPL_CACHE_REMOTE value from the environment if it is set.
   /*char* p;
   if ((p = getenv("CHPL_CACHE_REMOTE")) != NULL) {
@@ -2744,6 +2939,7 @@ void chpl_cache_init(void) {
   }
 
   //printf("CACHE IS ENABLED\n");
+  chpl_cache_read_config();
   chpl_cache_do_init();
 }
 
@@ -2851,6 +3047,7 @@ void chpl_cache_comm_prefetch(c_nodeid_t node, void* raddr,
            chpl_lookupFilename(fn), ln, node);
   // Always use the cache for prefetches.
   //saturating_increment(&info->prefetch_since_acquire);
+  CACHE_DIAG_INC(prefetches);
   cache_get(cache, NULL, node, (raddr_t)raddr, size, task_local->last_acquire,
             0, ln, fn);
 }
@@ -2939,6 +3136,53 @@ void chpl_cache_set_enabled(int enabled)
 }
 */
 
+void chpl_startCacheDiagnosticsHere(void) {
+  chpl_cache_diagnostics = 1;
+}
+
+void chpl_stopCacheDiagnosticsHere(void) {
+  chpl_cache_diagnostics = 0;
+}
+
+void chpl_resetCacheDiagnosticsHere(void) {
+  atomic_store_uint_least64_t(&cache_diags.get_hits, 0);
+  atomic_store_uint_least64_t(&cache_diags.get_partial_hits, 0);
+  atomic_store_uint_least64_t(&cache_diags.get_misses, 0);
+  atomic_store_uint_least64_t(&cache_diags.readahead_issued, 0);
+  atomic_store_uint_least64_t(&cache_diags.readahead_used, 0);
+  atomic_store_uint_least64_t(&cache_diags.prefetches, 0);
+  atomic_store_uint_least64_t(&cache_diags.dirty_flushes, 0);
+  atomic_store_uint_least64_t(&cache_diags.ain_evictions, 0);
+  atomic_store_uint_least64_t(&cache_diags.am_evictions, 0);
+  atomic_store_uint_least64_t(&cache_diags.acquire_invalidations, 0);
+}
+
+void chpl_getCacheDiagnosticsHere(chpl_cacheDiagnostics *cd) {
+  cd->get_hits = atomic_load_uint_least64_t(&cache_diags.get_hits);
+  cd->get_partial_hits =
+    atomic_load_uint_least64_t(&cache_diags.get_partial_hits);
+  cd->get_misses = atomic_load_uint_least64_t(&cache_diags.get_misses);
+  cd->readahead_issued =
+    atomic_load_uint_least64_t(&cache_diags.readahead_issued);
+  cd->readahead_used = atomic_load_uint_least64_t(&cache_diags.readahead_used);
+  cd->prefetches = atomic_load_uint_least64_t(&cache_diags.prefetches);
+  cd->dirty_flushes = atomic_load_uint_least64_t(&cache_diags.dirty_flushes);
+  cd->ain_evictions = atomic_load_uint_least64_t(&cache_diags.ain_evictions);
+  cd->am_evictions = atomic_load_uint_least64_t(&cache_diags.am_evictions);
+  cd->acquire_invalidations =
+    atomic_load_uint_least64_t(&cache_diags.acquire_invalidations);
+}
+
+#else // HAS_CHPL_CACHE_FNS
+
+// Without a remote data cache there is nothing to count.
+void chpl_startCacheDiagnosticsHere(void) { }
+void chpl_stopCacheDiagnosticsHere(void) { }
+void chpl_resetCacheDiagnosticsHere(void) { }
+void chpl_getCacheDiagnosticsHere(chpl_cacheDiagnostics *cd) {
+  memset(cd, 0, sizeof(chpl_cacheDiagnostics));
+}
+
 #endif
 // end ifdef HAS_CHPL_CACHE_FNS
 
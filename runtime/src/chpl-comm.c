@@ -22,12 +22,17 @@
 //  comm/<commlayer>/comm-<commlayer>.c
 //
 #include "chplrt.h"
+#include "chpl-atomics.h"
 #include "chpl-comm.h"
+#include "chpl-comm-no-warning-macros.h" // No warnings for chpl_comm_put
 #include "chpl-mem.h"
 #include "chpl-mem-consistency.h"
+#include "chpl-tasks.h"
+#include "error.h"
 
 #include <stdint.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 int32_t chpl_nodeID = -1;
@@ -77,6 +82,128 @@ void chpl_gen_stopCommDiagnosticsHere(void) {
 }
 
 
+//
+// Detailed comm diagnostics.  These are updated with atomic adds rather
+// than under the lock that protects chpl_commDiagnostics, so that tasks
+// talking to different locales don't serialize on it.  The per-locale
+// counts can't be allocated until the memory layer is up, so nothing is
+// recorded before chpl_comm_diags_init() has been called.
+//
+static atomic_uint_least64_t
+  diags_sizes[chpl_comm_diags_num_ops][CHPL_COMM_DIAGS_NUM_BUCKETS];
+static atomic_uint_least64_t
+  diags_latencies[chpl_comm_diags_num_ops][CHPL_COMM_DIAGS_NUM_BUCKETS];
+static atomic_uint_least64_t* diags_dests;      // [op][node]
+static int diags_inited;
+
+static inline
+int diags_bucket(uint64_t val) {
+  int i = 0;
+
+  while (val > 1 && i < CHPL_COMM_DIAGS_NUM_BUCKETS - 1) {
+    val >>= 1;
+    i++;
+  }
+  return i;
+}
+
+void chpl_comm_diags_init(void) {
+  size_t n = (size_t) chpl_comm_diags_num_ops * chpl_numNodes;
+  size_t i;
+  int op;
+
+  for (op = 0; op < chpl_comm_diags_num_ops; op++) {
+    for (i = 0; i < CHPL_COMM_DIAGS_NUM_BUCKETS; i++) {
+      atomic_init_uint_least64_t(&diags_sizes[op][i], 0);
+      atomic_init_uint_least64_t(&diags_latencies[op][i], 0);
+    }
+  }
+
+  diags_dests = (atomic_uint_least64_t*)
+                chpl_mem_allocMany(n, sizeof(*diags_dests),
+                                   CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+  for (i = 0; i < n; i++)
+    atomic_init_uint_least64_t(&diags_dests[i], 0);
+
+  diags_inited = 1;
+}
+
+void chpl_comm_diags_reset(void) {
+  size_t n = (size_t) chpl_comm_diags_num_ops * chpl_numNodes;
+  size_t i;
+  int op;
+
+  if (!diags_inited)
+    return;
+
+  for (op = 0; op < chpl_comm_diags_num_ops; op++) {
+    for (i = 0; i < CHPL_COMM_DIAGS_NUM_BUCKETS; i++) {
+      atomic_store_uint_least64_t(&diags_sizes[op][i], 0);
+      atomic_store_uint_least64_t(&diags_latencies[op][i], 0);
+    }
+  }
+  for (i = 0; i < n; i++)
+    atomic_store_uint_least64_t(&diags_dests[i], 0);
+}
+
+void chpl_comm_diags_count(chpl_comm_diags_op_t op, c_nodeid_t node,
+                           size_t size) {
+  if (!diags_inited)
+    return;
+
+  (void) atomic_fetch_add_uint_least64_t(
+           &diags_sizes[op][diags_bucket(size)], 1);
+  (void) atomic_fetch_add_uint_least64_t(
+           &diags_dests[op * chpl_numNodes + node], 1);
+}
+
+uint64_t chpl_comm_diags_time(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void chpl_comm_diags_latency(chpl_comm_diags_op_t op, uint64_t start) {
+  uint64_t elapsed = chpl_comm_diags_time() - start;
+
+  if (!diags_inited)
+    return;
+
+  (void) atomic_fetch_add_uint_least64_t(
+           &diags_latencies[op][diags_bucket(elapsed)], 1);
+}
+
+static
+void diags_get_histogram(atomic_uint_least64_t* hist, uint64_t* buckets) {
+  int i;
+
+  for (i = 0; i < CHPL_COMM_DIAGS_NUM_BUCKETS; i++)
+    buckets[i] = diags_inited ? atomic_load_uint_least64_t(&hist[i]) : 0;
+}
+
+void chpl_getCommSizeHistogramHere(int32_t op, uint64_t* buckets) {
+  diags_get_histogram(diags_sizes[op], buckets);
+}
+
+void chpl_getCommLatencyHistogramHere(int32_t op, uint64_t* buckets) {
+  diags_get_histogram(diags_latencies[op], buckets);
+}
+
+void chpl_getCommDestCountsHere(int32_t op, uint64_t* counts) {
+  c_nodeid_t node;
+
+  if (!diags_inited) {
+    memset(counts, 0, chpl_numNodes * sizeof(*counts));
+    return;
+  }
+
+  for (node = 0; node < chpl_numNodes; node++)
+    counts[node] =
+      atomic_load_uint_least64_t(&diags_dests[op * chpl_numNodes + node]);
+}
+
+
 size_t chpl_comm_getenvMaxHeapSize(void)
 {
   char*  p;
@@ -113,3 +240,202 @@ size_t chpl_comm_getenvMaxHeapSize(void)
 
   return size;
 }
+
+
+//
+// Aggregated remote updates.
+//
+// Each aggregator has one buffer per locale.  A buffer holds a sequence
+// of records, each made up of an agg_rec_hdr_t followed by its data,
+// padded so that every header is 8-byte aligned.  The comm layer sends
+// a full buffer as a single message and calls chpl_comm_agg_ack() once
+// the destination has applied it.  The aggregator counts the messages
+// it has sent and the acks it has received, so a flush just has to send
+// any partially filled buffers and wait for the two counts to match.
+//
+#define AGG_DEFAULT_BUF_SIZE 8192
+
+#define AGG_OP_PUT       0
+#define AGG_OP_ADD_INT64 1
+
+typedef struct {
+  void*    raddr;
+  uint32_t op;
+  uint32_t size;
+} agg_rec_hdr_t;
+
+#define AGG_ALIGN(sz) (((sz) + 7) & ~((size_t) 7))
+
+typedef struct {
+  size_t used;
+  char*  data;                  // allocated on first use
+} agg_buf_t;
+
+typedef struct {
+  size_t                buf_size;
+  agg_buf_t*            bufs;   // one per locale
+  uint_least64_t        sent;
+  atomic_uint_least64_t acks;
+} agg_t;
+
+
+static inline
+void agg_apply_one(agg_rec_hdr_t* hdr, void* data) {
+  switch (hdr->op) {
+  case AGG_OP_PUT:
+    memcpy(hdr->raddr, data, hdr->size);
+    break;
+  case AGG_OP_ADD_INT64:
+    (void) __sync_fetch_and_add((int64_t*) hdr->raddr, *(int64_t*) data);
+    break;
+  default:
+    chpl_internal_error("unknown aggregated update");
+  }
+}
+
+
+void chpl_comm_agg_apply(void* buf, size_t size) {
+  char* p = (char*) buf;
+  char* end = p + size;
+
+  while (p < end) {
+    agg_rec_hdr_t* hdr = (agg_rec_hdr_t*) p;
+    agg_apply_one(hdr, p + sizeof(*hdr));
+    p += sizeof(*hdr) + AGG_ALIGN(hdr->size);
+  }
+}
+
+
+void chpl_comm_agg_ack(void* ack) {
+  (void) atomic_fetch_add_uint_least64_t((atomic_uint_least64_t*) ack, 1);
+}
+
+
+void* chpl_comm_agg_create(void) {
+  agg_t* agg;
+  size_t max_size;
+
+  agg = (agg_t*) chpl_mem_alloc(sizeof(*agg), CHPL_RT_MD_COMM_AGG_BUF, 0, 0);
+  agg->buf_size = AGG_DEFAULT_BUF_SIZE;
+  max_size = chpl_comm_agg_max_msg_size();
+  if (max_size < agg->buf_size)
+    agg->buf_size = max_size;
+  agg->bufs = (agg_buf_t*) chpl_mem_calloc(chpl_numNodes, sizeof(agg_buf_t),
+                                           CHPL_RT_MD_COMM_AGG_BUF, 0, 0);
+  agg->sent = 0;
+  atomic_init_uint_least64_t(&agg->acks, 0);
+  return agg;
+}
+
+
+static
+void agg_send_buf(agg_t* agg, c_nodeid_t node) {
+  agg_buf_t* b = &agg->bufs[node];
+
+  if (b->used == 0)
+    return;
+
+  agg->sent++;
+  chpl_comm_agg_send(node, b->data, b->used, &agg->acks);
+  b->used = 0;
+}
+
+
+//
+// Append a record to the buffer for 'node', sending the buffer first
+// if the record won't fit.  Returns a pointer to the record's data, or
+// NULL if the record is too big to fit in any buffer.
+//
+static
+void* agg_append(agg_t* agg, c_nodeid_t node, void* raddr,
+                 uint32_t op, size_t size) {
+  agg_buf_t* b = &agg->bufs[node];
+  size_t rec_size = sizeof(agg_rec_hdr_t) + AGG_ALIGN(size);
+  agg_rec_hdr_t* hdr;
+
+  if (rec_size > agg->buf_size)
+    return NULL;
+
+  if (b->data == NULL)
+    b->data = (char*) chpl_mem_alloc(agg->buf_size,
+                                     CHPL_RT_MD_COMM_AGG_BUF, 0, 0);
+  else if (b->used + rec_size > agg->buf_size)
+    agg_send_buf(agg, node);
+
+  hdr = (agg_rec_hdr_t*) (b->data + b->used);
+  hdr->raddr = raddr;
+  hdr->op = op;
+  hdr->size = (uint32_t) size;
+  b->used += rec_size;
+  return hdr + 1;
+}
+
+
+void chpl_comm_agg_put(void* agg_p, c_nodeid_t node, void* raddr,
+                       void* addr, size_t size) {
+  agg_t* agg = (agg_t*) agg_p;
+  void* data;
+
+  if (node == chpl_nodeID) {
+    memcpy(raddr, addr, size);
+    return;
+  }
+
+  if ((data = agg_append(agg, node, raddr, AGG_OP_PUT, size)) != NULL) {
+    memcpy(data, addr, size);
+    return;
+  }
+
+  //
+  // Too big to aggregate.  Make sure everything we've buffered so far
+  // lands first, so this PUT isn't overtaken by earlier ones.
+  //
+  chpl_comm_agg_flush(agg);
+  chpl_comm_put(addr, node, raddr, size, CHPL_TYPE_uint8_t, 0, 0);
+}
+
+
+void chpl_comm_agg_add_int64(void* agg_p, c_nodeid_t node, void* raddr,
+                             int64_t val) {
+  agg_t* agg = (agg_t*) agg_p;
+  agg_rec_hdr_t hdr = { raddr, AGG_OP_ADD_INT64, sizeof(val) };
+  void* data;
+
+  if (node == chpl_nodeID) {
+    agg_apply_one(&hdr, &val);
+    return;
+  }
+
+  data = agg_append(agg, node, raddr, AGG_OP_ADD_INT64, sizeof(val));
+  memcpy(data, &val, sizeof(val));
+}
+
+
+void chpl_comm_agg_flush(void* agg_p) {
+  agg_t* agg = (agg_t*) agg_p;
+  c_nodeid_t node;
+
+  for (node = 0; node < chpl_numNodes; node++)
+    agg_send_buf(agg, node);
+
+  while (atomic_load_uint_least64_t(&agg->acks) < agg->sent) {
+    chpl_comm_make_progress();
+    chpl_task_yield();
+  }
+}
+
+
+void chpl_comm_agg_destroy(void* agg_p) {
+  agg_t* agg = (agg_t*) agg_p;
+  c_nodeid_t node;
+
+  chpl_comm_agg_flush(agg);
+
+  for (node = 0; node < chpl_numNodes; node++) {
+    if (agg->bufs[node].data != NULL)
+      chpl_mem_free(agg->bufs[node].data, 0, 0);
+  }
+  chpl_mem_free(agg->bufs, 0, 0);
+  atomic_destroy_uint_least64_t(&agg->acks);
+  chpl_mem_free(agg, 0, 0);
+}
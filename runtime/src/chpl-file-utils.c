@@ -27,9 +27,15 @@
 
 #include <stdio.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/param.h> // MAXPATHLEN
 #include <sys/stat.h>
 #include <utime.h> // Defines utimbuf and utime()
+#ifdef __linux__
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
 
 
 qioerr chpl_fs_chdir(const char* name) {
@@ -56,6 +62,140 @@ qioerr chpl_fs_chown(const char* name, int uid, int gid) {
   return err;
 }
 
+// Largest request handed to copy_file_range() or sendfile() at once, and
+// the buffer size used when neither is available.
+#define CHPL_FS_COPY_CHUNK   (1024*1024*1024)
+#define CHPL_FS_COPY_BUFSIZE (1024*1024)
+
+// errno values that mean the kernel can't do the copy for us (old
+// kernel, different file systems, unsupported file types), so we
+// should try the next method rather than report an error.
+static int _chpl_fs_copy_unsupported(int err) {
+  return err == ENOSYS || err == EXDEV || err == EINVAL ||
+         err == EOPNOTSUPP || err == EBADF;
+}
+
+// Copies from offset *copied in infd to the same offset in outfd until
+// the end of infd, updating *copied.  Tries copy_file_range() and
+// sendfile(), which keep the data in the kernel, before falling back to
+// read() and write() through a large buffer.
+static qioerr _chpl_fs_copy_fds(int infd, int outfd, off_t size,
+                                off_t* copied) {
+  ssize_t got;
+  char* buf;
+
+#if defined(__linux__) && defined(SYS_copy_file_range)
+  while (*copied < size) {
+    loff_t inoff = *copied;
+    loff_t outoff = *copied;
+    got = syscall(SYS_copy_file_range, infd, &inoff, outfd, &outoff,
+                  (size_t)CHPL_FS_COPY_CHUNK, 0);
+    if (got > 0) {
+      *copied += got;
+    } else if (got == 0) {
+      // The file is shorter than it was, or this file system reports
+      // nothing to copy (e.g. /proc); let read() find the real end.
+      break;
+    } else if (errno == EINTR) {
+      continue;
+    } else if (_chpl_fs_copy_unsupported(errno)) {
+      break;
+    } else {
+      return qio_mkerror_errno();
+    }
+  }
+#endif
+
+#ifdef __linux__
+  // sendfile() writes at the current offset of outfd.
+  if (*copied < size &&
+      (*copied == 0 || lseek(outfd, *copied, SEEK_SET) == *copied)) {
+    while (*copied < size) {
+      off_t inoff = *copied;
+      got = sendfile(outfd, infd, &inoff, (size_t)CHPL_FS_COPY_CHUNK);
+      if (got > 0) {
+        *copied += got;
+      } else if (got == 0) {
+        break;
+      } else if (errno == EINTR) {
+        continue;
+      } else if (_chpl_fs_copy_unsupported(errno)) {
+        break;
+      } else {
+        return qio_mkerror_errno();
+      }
+    }
+  }
+#endif
+
+  // Copy whatever remains, and make sure we have reached the end of infd.
+  // Both descriptors are still at offset 0 if nothing has been copied,
+  // which also keeps this working for descriptors that can't seek.
+  if (*copied > 0 &&
+      (lseek(infd, *copied, SEEK_SET) != *copied ||
+       lseek(outfd, *copied, SEEK_SET) != *copied))
+    return qio_mkerror_errno();
+
+  buf = (char*) qio_malloc(CHPL_FS_COPY_BUFSIZE);
+  if (buf == NULL)
+    return QIO_ENOMEM;
+  while (1) {
+    ssize_t put = 0;
+    got = read(infd, buf, CHPL_FS_COPY_BUFSIZE);
+    if (got == 0)
+      break;
+    if (got < 0) {
+      if (errno == EINTR)
+        continue;
+      qio_free(buf);
+      return qio_mkerror_errno();
+    }
+    while (put < got) {
+      ssize_t wrote = write(outfd, buf + put, got - put);
+      if (wrote < 0) {
+        if (errno == EINTR)
+          continue;
+        qio_free(buf);
+        return qio_mkerror_errno();
+      }
+      put += wrote;
+    }
+    *copied += got;
+  }
+  qio_free(buf);
+  return 0;
+}
+
+qioerr chpl_fs_copy_file(const char* source, const char* dest) {
+  qioerr err = 0;
+  struct stat srcStat;
+  off_t copied = 0;
+  int infd, outfd;
+
+  infd = open(source, O_RDONLY);
+  if (infd < 0)
+    return qio_mkerror_errno();
+  if (fstat(infd, &srcStat)) {
+    err = qio_mkerror_errno();
+    close(infd);
+    return err;
+  }
+  // Same creation mode as opening the file with iomode.cw.
+  outfd = open(dest, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (outfd < 0) {
+    err = qio_mkerror_errno();
+    close(infd);
+    return err;
+  }
+
+  err = _chpl_fs_copy_fds(infd, outfd, srcStat.st_size, &copied);
+
+  close(infd);
+  if (close(outfd) && !err)
+    err = qio_mkerror_errno();
+  return err;
+}
+
 qioerr chpl_fs_copy_metadata(const char* source, const char* dest) {
   qioerr err = 0;
   struct stat oldTimes;
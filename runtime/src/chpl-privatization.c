@@ -19,78 +19,131 @@
 
 #include "chplrt.h"
 #include "chpl-privatization.h"
+#include "chpl-atomics.h"
 #include "chpl-mem.h"
 #include "chpl-tasks.h"
-
-static int64_t chpl_capPrivateObjects = 0;
-static chpl_sync_aux_t privatizationSync;
-
-static void** chpl_privateObjects = NULL;
+#include "error.h"
+
+//
+// Privatized objects are kept in a two-level table: a fixed directory of
+// chunk pointers, each chunk holding CHPL_PRIVATIZATION_CHUNK_SIZE objects.
+// Chunks are allocated on first use and never move or get freed, so lookups
+// need no lock and growing the table never copies it.  The only lock is
+// taken to allocate a chunk, which happens at most once per chunk.
+//
+void* chpl_privateObjects[CHPL_PRIVATIZATION_DIR_SIZE];
+
+static chpl_sync_aux_t chunkSync;
+
+//
+// Pids are handed out on locale 0.  Released pids go on a lock-free stack
+// so that programs creating and freeing many distributed objects keep
+// reusing a compact range of pids.  The stack head packs a tag that is
+// bumped on every pop with the top pid plus one, so a pid that is popped
+// and pushed again between another task's read and CAS does not fool that
+// task.  The links live in a second table with the same layout as the
+// objects.
+//
+static atomic_int_least64_t nextPid;
+static atomic_int_least64_t freePidHead;
+static void* freePidLinks[CHPL_PRIVATIZATION_DIR_SIZE];
+
+#define FREE_PID_BITS 32
+#define FREE_PID_MASK ((INT64_C(1) << FREE_PID_BITS) - 1)
 
 void chpl_privatization_init(void) {
-    chpl_sync_initAux(&privatizationSync);
+  chpl_sync_initAux(&chunkSync);
+  atomic_init_int_least64_t(&nextPid, 0);
+  atomic_init_int_least64_t(&freePidHead, 0);
 }
 
-static inline int64_t max(int64_t a, int64_t b) {
-  return a > b ? a : b;
+static void checkPid(int64_t pid) {
+  if (pid < 0 || (pid >> CHPL_PRIVATIZATION_CHUNK_LOG2) >=
+                 CHPL_PRIVATIZATION_DIR_SIZE)
+    chpl_internal_error("privatized object id out of range");
+}
+
+// Make sure the chunk holding 'pid' exists in the given directory
+static void* getChunk(void** dir, int64_t pid, size_t eltSize) {
+  int64_t c = pid >> CHPL_PRIVATIZATION_CHUNK_LOG2;
+  if (dir[c] == NULL) {
+    chpl_sync_lock(&chunkSync);
+    if (dir[c] == NULL) {
+      void* chunk = chpl_mem_allocManyZero(CHPL_PRIVATIZATION_CHUNK_SIZE,
+                                           eltSize,
+                                           CHPL_RT_MD_COMM_PRV_OBJ_ARRAY,
+                                           0, 0);
+      // the chunk must be zeroed before anyone can see it
+      atomic_thread_fence(memory_order_release);
+      dir[c] = chunk;
+    }
+    chpl_sync_unlock(&chunkSync);
+  }
+  return dir[c];
 }
 
 // Note that this function can be called in parallel and more notably it can be
 // called with non-monotonic pid's. e.g. this may be called with pid 27, and
-// then pid 2, so it has to ensure that the privatized array has at least pid+1
-// elements. Be __very__ careful if you have to update it.
+// then pid 2, so it has to ensure that the chunk holding pid exists.
 void chpl_newPrivatizedClass(void* v, int64_t pid) {
-  chpl_sync_lock(&privatizationSync);
-
-  // initialize array to a default size
-  if (chpl_privateObjects == NULL) {
-    chpl_capPrivateObjects = 2*max(pid, 4);
-    chpl_privateObjects =
-        chpl_mem_allocManyZero(chpl_capPrivateObjects, sizeof(void *),
-                           CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-  } else {
-    // if we're out of space, double (or more) the array size
-    if (pid >= chpl_capPrivateObjects) {
-      void** tmp;
-      int64_t oldCap;
-
-      oldCap = chpl_capPrivateObjects;
-      chpl_capPrivateObjects = 2*max(pid, oldCap);
-
-      tmp = chpl_mem_allocManyZero(chpl_capPrivateObjects, sizeof(void *),
-                                   CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-      chpl_memcpy((void*)tmp, (void*)chpl_privateObjects, (oldCap)*sizeof(void*));
-      chpl_privateObjects = tmp;
-      // purposely leak old copies of chpl_privateObject to avoid the need to
-      // lock chpl_getPrivatizedClass; TODO: fix with lock free data structure
-    }
-  }
-  chpl_privateObjects[pid] = v;
+  void** chunk;
 
-  chpl_sync_unlock(&privatizationSync);
+  checkPid(pid);
+  chunk = getChunk(chpl_privateObjects, pid, sizeof(void*));
+  chunk[pid & CHPL_PRIVATIZATION_CHUNK_MASK] = v;
 }
 
 
-void* chpl_getPrivatizedClass(int64_t i) {
-  return chpl_privateObjects[i];
+void chpl_clearPrivatizedClass(int64_t i) {
+  void** chunk = chpl_privateObjects[i >> CHPL_PRIVATIZATION_CHUNK_LOG2];
+  chunk[i & CHPL_PRIVATIZATION_CHUNK_MASK] = NULL;
 }
 
 
-void chpl_clearPrivatizedClass(int64_t i) {
-  chpl_sync_lock(&privatizationSync);
-  chpl_privateObjects[i] = NULL;
-  chpl_sync_unlock(&privatizationSync);
+int64_t chpl_reservePrivatizedPid(void) {
+  int64_t head = atomic_load_int_least64_t(&freePidHead);
+
+  while ((head & FREE_PID_MASK) != 0) {
+    int64_t pid = (head & FREE_PID_MASK) - 1;
+    int64_t* links = freePidLinks[pid >> CHPL_PRIVATIZATION_CHUNK_LOG2];
+    int64_t next = links[pid & CHPL_PRIVATIZATION_CHUNK_MASK];
+    int64_t tag = (head >> FREE_PID_BITS) + 1;
+    int64_t newHead = (tag << FREE_PID_BITS) | next;
+    if (atomic_compare_exchange_strong_int_least64_t(&freePidHead,
+                                                     head, newHead))
+      return pid;
+    head = atomic_load_int_least64_t(&freePidHead);
+  }
+
+  return atomic_fetch_add_int_least64_t(&nextPid, 1);
+}
+
+
+void chpl_releasePrivatizedPid(int64_t pid) {
+  int64_t* links;
+  int64_t head, newHead;
+
+  checkPid(pid);
+  links = getChunk(freePidLinks, pid, sizeof(int64_t));
+  do {
+    head = atomic_load_int_least64_t(&freePidHead);
+    links[pid & CHPL_PRIVATIZATION_CHUNK_MASK] = head & FREE_PID_MASK;
+    newHead = (head & ~FREE_PID_MASK) | (pid + 1);
+  } while (!atomic_compare_exchange_strong_int_least64_t(&freePidHead,
+                                                         head, newHead));
 }
 
 // Used to check for leaks of privatized classes
 int64_t chpl_numPrivatizedClasses(void) {
   int64_t ret = 0;
-  chpl_sync_lock(&privatizationSync);
-  for (int64_t i = 0; i < chpl_capPrivateObjects; i++) {
-    if (chpl_privateObjects[i])
-      ret++;
+  for (int64_t c = 0; c < CHPL_PRIVATIZATION_DIR_SIZE; c++) {
+    void** chunk = chpl_privateObjects[c];
+    if (chunk == NULL)
+      continue;
+    for (int64_t i = 0; i < CHPL_PRIVATIZATION_CHUNK_SIZE; i++) {
+      if (chunk[i])
+        ret++;
+    }
   }
-  chpl_sync_unlock(&privatizationSync);
   return ret;
 }
-
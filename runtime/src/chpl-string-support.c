@@ -32,6 +32,13 @@
  *
  */
 #include <stdarg.h>
+// The vector intrinsics headers must precede chpl-mem.h, which poisons
+// malloc() and free().
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include "chplrt.h"
 #include "sys_basic.h"
 #include "chpl-mem.h"
@@ -207,3 +214,218 @@ string_contains(c_string x, c_string y) {
 }
 
 
+
+
+//
+// Substring search
+//
+// Needles of up to STRING_SEARCH_LONG_NEEDLE bytes are found by comparing
+// the first and last needle bytes against a whole vector of haystack
+// positions at once, and only calling memcmp() for positions where both
+// match.  Longer needles use Boyer-Moore-Horspool, which can skip up to a
+// needle length of haystack per step.  Without SSE2 or AVX2, short needles
+// are located by scanning for their first byte with memchr().
+//
+#if defined(__AVX2__)
+#define STRING_SEARCH_VEC_WIDTH 32
+typedef __m256i string_search_vec_t;
+#define string_search_splat(c) _mm256_set1_epi8(c)
+#define string_search_load(p) _mm256_loadu_si256((const __m256i*) (p))
+#define string_search_match(f, vf, l, vl)                                  \
+  ((uint32_t) _mm256_movemask_epi8(                                        \
+    _mm256_and_si256(_mm256_cmpeq_epi8(f, vf), _mm256_cmpeq_epi8(l, vl))))
+#elif defined(__SSE2__)
+#define STRING_SEARCH_VEC_WIDTH 16
+typedef __m128i string_search_vec_t;
+#define string_search_splat(c) _mm_set1_epi8(c)
+#define string_search_load(p) _mm_loadu_si128((const __m128i*) (p))
+#define string_search_match(f, vf, l, vl)                                  \
+  ((uint32_t) _mm_movemask_epi8(                                           \
+    _mm_and_si128(_mm_cmpeq_epi8(f, vf), _mm_cmpeq_epi8(l, vl))))
+#endif
+
+#define STRING_SEARCH_LONG_NEEDLE 32
+
+// Does the needle occur at h, given that its first and last bytes do?
+static inline
+chpl_bool string_search_inner_match(const char* h, const char* n,
+                                    int64_t nlen) {
+  return nlen <= 2 || memcmp(h + 1, n + 1, nlen - 2) == 0;
+}
+
+static
+void string_search_horspool_init(int64_t* skip, const char* n, int64_t nlen,
+                                 chpl_bool fromLeft) {
+  int64_t i;
+
+  for (i = 0; i < 256; i++)
+    skip[i] = nlen;
+  if (fromLeft) {
+    // distance from each byte's last occurrence to the end of the needle
+    for (i = 0; i < nlen - 1; i++)
+      skip[(unsigned char) n[i]] = nlen - 1 - i;
+  } else {
+    // distance from the start of the needle to each byte's first occurrence
+    for (i = nlen - 1; i > 0; i--)
+      skip[(unsigned char) n[i]] = i;
+  }
+}
+
+static
+int64_t string_search_forward(const char* h, int64_t hlen,
+                              const char* n, int64_t nlen,
+                              const int64_t* skip) {
+  const char first = n[0];
+  const char last = n[nlen - 1];
+  int64_t i = 0;
+
+  if (nlen == 1) {
+    const char* p = memchr(h, first, hlen);
+    return p ? p - h : -1;
+  }
+
+  if (skip != NULL) {
+    for (i = 0; i <= hlen - nlen;
+         i += skip[(unsigned char) h[i + nlen - 1]]) {
+      if (h[i + nlen - 1] == last && memcmp(h + i, n, nlen - 1) == 0)
+        return i;
+    }
+    return -1;
+  }
+
+#ifdef STRING_SEARCH_VEC_WIDTH
+  {
+    const string_search_vec_t vfirst = string_search_splat(first);
+    const string_search_vec_t vlast = string_search_splat(last);
+
+    for (; i + nlen - 1 + STRING_SEARCH_VEC_WIDTH <= hlen;
+         i += STRING_SEARCH_VEC_WIDTH) {
+      uint32_t mask =
+        string_search_match(vfirst, string_search_load(h + i),
+                            vlast, string_search_load(h + i + nlen - 1));
+      while (mask != 0) {
+        const int bit = __builtin_ctz(mask);
+        if (string_search_inner_match(h + i + bit, n, nlen))
+          return i + bit;
+        mask &= mask - 1;
+      }
+    }
+  }
+#endif
+
+  while (i <= hlen - nlen) {
+    const char* p = memchr(h + i, first, hlen - nlen + 1 - i);
+    if (p == NULL)
+      return -1;
+    i = p - h;
+    if (h[i + nlen - 1] == last && string_search_inner_match(h + i, n, nlen))
+      return i;
+    i++;
+  }
+  return -1;
+}
+
+static
+int64_t string_search_backward(const char* h, int64_t hlen,
+                               const char* n, int64_t nlen,
+                               const int64_t* skip) {
+  const char first = n[0];
+  const char last = n[nlen - 1];
+  int64_t top = hlen - nlen;  // the last position the needle could start at
+
+  if (skip != NULL) {
+    for (; top >= 0; top -= skip[(unsigned char) h[top]]) {
+      if (h[top] == first && memcmp(h + top + 1, n + 1, nlen - 1) == 0)
+        return top;
+    }
+    return -1;
+  }
+
+#ifdef STRING_SEARCH_VEC_WIDTH
+  {
+    const string_search_vec_t vfirst = string_search_splat(first);
+    const string_search_vec_t vlast = string_search_splat(last);
+
+    for (; top - (STRING_SEARCH_VEC_WIDTH - 1) >= 0;
+         top -= STRING_SEARCH_VEC_WIDTH) {
+      const int64_t i = top - (STRING_SEARCH_VEC_WIDTH - 1);
+      uint32_t mask =
+        string_search_match(vfirst, string_search_load(h + i),
+                            vlast, string_search_load(h + i + nlen - 1));
+      while (mask != 0) {
+        const int bit = 31 - __builtin_clz(mask);
+        if (string_search_inner_match(h + i + bit, n, nlen))
+          return i + bit;
+        mask &= ~(1u << bit);
+      }
+    }
+  }
+#endif
+
+  for (; top >= 0; top--) {
+    if (h[top] == first && h[top + nlen - 1] == last &&
+        string_search_inner_match(h + top, n, nlen))
+      return top;
+  }
+  return -1;
+}
+
+int64_t chpl_string_find(const void* haystack, int64_t hlen,
+                         const void* needle, int64_t nlen) {
+  int64_t skip[256];
+
+  if (nlen > hlen)
+    return -1;
+  if (nlen < STRING_SEARCH_LONG_NEEDLE)
+    return string_search_forward(haystack, hlen, needle, nlen, NULL);
+
+  string_search_horspool_init(skip, needle, nlen, true);
+  return string_search_forward(haystack, hlen, needle, nlen, skip);
+}
+
+int64_t chpl_string_rfind(const void* haystack, int64_t hlen,
+                          const void* needle, int64_t nlen) {
+  int64_t skip[256];
+
+  if (nlen > hlen)
+    return -1;
+  if (nlen < STRING_SEARCH_LONG_NEEDLE)
+    return string_search_backward(haystack, hlen, needle, nlen, NULL);
+
+  string_search_horspool_init(skip, needle, nlen, false);
+  return string_search_backward(haystack, hlen, needle, nlen, skip);
+}
+
+int64_t chpl_string_count(const void* haystack, int64_t hlen,
+                          const void* needle, int64_t nlen) {
+  const char* h = haystack;
+  int64_t skip[256];
+  int64_t* skipp = NULL;
+  int64_t count = 0;
+  int64_t pos = 0;
+
+  if (nlen > hlen)
+    return 0;
+
+  if (nlen == 1) {
+    const char c = *(const char*) needle;
+    for (pos = 0; pos < hlen; pos++)
+      count += h[pos] == c;
+    return count;
+  }
+
+  if (nlen >= STRING_SEARCH_LONG_NEEDLE) {
+    string_search_horspool_init(skip, needle, nlen, true);
+    skipp = skip;
+  }
+
+  while (pos <= hlen - nlen) {
+    const int64_t offset = string_search_forward(h + pos, hlen - pos,
+                                                 needle, nlen, skipp);
+    if (offset < 0)
+      break;
+    count++;
+    pos += offset + 1;
+  }
+  return count;
+}
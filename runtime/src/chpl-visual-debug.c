@@ -22,12 +22,16 @@
 //
 
 #include "chpl-visual-debug.h"
+#include "chpl-visual-debug-format.h"
 #include "chplrt.h"
 #include "chpl-comm.h"
 #include "chpl-tasks.h"
 #include "chpl-tasks-callbacks.h"
 #include "chpl-comm-callbacks.h"
 #include "chpl-linefile-support.h"
+#include "chpl-mem.h"
+#include "chpl-thread-local-storage.h"
+#include <pthread.h>
 #include <stdint.h>
 #include <string.h>
 #include <unistd.h>
@@ -63,6 +67,7 @@ static void cb_comm_executeOn_fast(const chpl_comm_cb_info_t *info);
 
 int chpl_vdebug_fd = -1;
 int chpl_vdebug = 0;
+int chpl_vdebug_binary = 0;
 
 int chpl_dprintf (int fd, const char * format, ...) {
   char buffer[2048]; 
@@ -81,6 +86,201 @@ int chpl_dprintf (int fd, const char * format, ...) {
   return -1;
 }
 
+//
+// Binary data files
+//
+// Event records are collected in a buffer private to the logging thread
+// and written with a single write() when the buffer fills, when it has
+// not been written for VDB_FLUSH_USEC, or when a tag, pause or stop
+// flushes all of the buffers.  Each write is a whole number of records
+// to a file opened with O_APPEND, so concurrent flushes don't interleave.
+//
+
+#define VDB_BUF_RECS   256        // records in each thread's buffer
+#define VDB_FLUSH_USEC 1000000    // maximum time between buffer flushes
+
+typedef struct vdb_buf_s {
+  struct vdb_buf_s *next;         // list of all buffers on this node
+  pthread_mutex_t lock;           // owner vs. flushes from other threads
+  int64_t lastFlush;              // time of the last flush
+  int n;                          // number of records in recs
+  chpl_vdebug_rec_t recs[VDB_BUF_RECS];
+} vdb_buf_t;
+
+static CHPL_TLS_DECL(vdb_buf_t*, vdb_thread_buf);
+static vdb_buf_t *vdb_bufs = NULL;
+static pthread_mutex_t vdb_bufs_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static inline int64_t vdb_usec (const struct timeval *tv) {
+  return (int64_t) tv->tv_sec * 1000000 + tv->tv_usec;
+}
+
+// Write all of buf to the data file, retrying short writes.
+
+static int vdb_write (const void *buf, size_t size) {
+  const char *p = (const char *) buf;
+  while (size > 0) {
+    ssize_t wrv = write (chpl_vdebug_fd, p, size);
+    if (wrv < 0) {
+      if (errno == EINTR) continue;
+      return -1;
+    }
+    p += wrv;
+    size -= wrv;
+  }
+  return 0;
+}
+
+// Must be called with buf->lock held.
+
+static void vdb_flush_buf (vdb_buf_t *buf, int64_t now) {
+  if (buf->n > 0 && chpl_vdebug_fd >= 0)
+    (void) vdb_write (buf->recs, buf->n * sizeof (chpl_vdebug_rec_t));
+  buf->n = 0;
+  buf->lastFlush = now;
+}
+
+static void vdb_flush_all (void) {
+  struct timeval tv;
+  vdb_buf_t *buf;
+  (void) gettimeofday (&tv, NULL);
+  pthread_mutex_lock (&vdb_bufs_lock);
+  for (buf = vdb_bufs; buf != NULL; buf = buf->next) {
+    pthread_mutex_lock (&buf->lock);
+    vdb_flush_buf (buf, vdb_usec (&tv));
+    pthread_mutex_unlock (&buf->lock);
+  }
+  pthread_mutex_unlock (&vdb_bufs_lock);
+}
+
+// Buffers are never freed; a thread keeps its buffer across
+// start/stop pairs.
+
+static vdb_buf_t *vdb_get_buf (int64_t now) {
+  vdb_buf_t *buf = CHPL_TLS_GET(vdb_thread_buf);
+  if (buf == NULL) {
+    buf = (vdb_buf_t *) chpl_malloc (sizeof (vdb_buf_t));
+    if (buf == NULL)
+      return NULL;
+    pthread_mutex_init (&buf->lock, NULL);
+    buf->lastFlush = now;
+    buf->n = 0;
+    pthread_mutex_lock (&vdb_bufs_lock);
+    buf->next = vdb_bufs;
+    vdb_bufs = buf;
+    pthread_mutex_unlock (&vdb_bufs_lock);
+    CHPL_TLS_SET(vdb_thread_buf, buf);
+  }
+  return buf;
+}
+
+static void vdb_log (const chpl_vdebug_rec_t *rec) {
+  vdb_buf_t *buf = vdb_get_buf (rec->time);
+  if (buf == NULL)
+    return;
+  pthread_mutex_lock (&buf->lock);
+  buf->recs[buf->n++] = *rec;
+  if (buf->n == VDB_BUF_RECS || rec->time - buf->lastFlush >= VDB_FLUSH_USEC)
+    vdb_flush_buf (buf, rec->time);
+  pthread_mutex_unlock (&buf->lock);
+}
+
+static void vdb_init_rec (chpl_vdebug_rec_t *rec, chpl_vdebug_rec_kind_t kind,
+                          const struct timeval *tv, int nid,
+                          chpl_taskID_t tid) {
+  memset (rec, 0, sizeof (*rec));
+  rec->kind = kind;
+  rec->nid = nid;
+  rec->time = tv == NULL ? 0 : vdb_usec (tv);
+  rec->tid = (int64_t) tid;
+}
+
+// String records go directly to the file, followed by the string.
+
+static void vdb_write_string (chpl_vdebug_rec_kind_t kind, int ix,
+                              int lineno, int fileno, const char *str) {
+  size_t len = strlen (str);
+  size_t nrecs = 1 + CHPL_VDEBUG_STR_RECS(len);
+  chpl_vdebug_rec_t *recs;
+
+  recs = (chpl_vdebug_rec_t *) chpl_malloc (nrecs * sizeof (chpl_vdebug_rec_t));
+  if (recs == NULL)
+    return;
+  memset (recs, 0, nrecs * sizeof (chpl_vdebug_rec_t));
+  vdb_init_rec (&recs[0], kind, NULL, chpl_nodeID, 0);
+  recs[0].u.str.ix = ix;
+  recs[0].u.str.lineno = lineno;
+  recs[0].u.str.fileno = fileno;
+  recs[0].u.str.len = (int32_t) len;
+  memcpy (&recs[1], str, len);
+  (void) vdb_write (recs, nrecs * sizeof (chpl_vdebug_rec_t));
+  chpl_free (recs);
+}
+
+// Tag, pause and end records order the events in the file, so all
+// of the buffered events are written before them.
+
+static void vdb_write_times (chpl_vdebug_rec_kind_t kind,
+                             const struct timeval *tv,
+                             const struct rusage *ru,
+                             chpl_taskID_t tid, int tagno) {
+  chpl_vdebug_rec_t rec;
+  vdb_flush_all ();
+  vdb_init_rec (&rec, kind, tv, chpl_nodeID, tid);
+  rec.u.times.utime = vdb_usec (&ru->ru_utime);
+  rec.u.times.stime = vdb_usec (&ru->ru_stime);
+  rec.u.times.tagno = tagno;
+  (void) vdb_write (&rec, sizeof (rec));
+}
+
+static void vdb_log_comm (chpl_vdebug_rec_kind_t kind,
+                          const struct timeval *tv,
+                          const chpl_comm_cb_info_t *info,
+                          chpl_taskID_t tid) {
+  const struct chpl_comm_info_comm *cm = &info->iu.comm;
+  chpl_vdebug_rec_t rec;
+  vdb_init_rec (&rec, kind, tv, info->localNodeID, tid);
+  rec.u.comm.size = (int64_t) cm->size;
+  rec.u.comm.rnid = info->remoteNodeID;
+  rec.u.comm.typeIndex = cm->typeIndex;
+  rec.u.comm.lineno = cm->lineno;
+  rec.u.comm.fileno = cm->filename;
+  vdb_log (&rec);
+}
+
+static void vdb_log_comm_strd (chpl_vdebug_rec_kind_t kind,
+                               const struct timeval *tv,
+                               const chpl_comm_cb_info_t *info,
+                               chpl_taskID_t tid) {
+  const struct chpl_comm_info_comm_strd *cm = &info->iu.comm_strd;
+  chpl_vdebug_rec_t rec;
+  int64_t size = cm->elemSize;
+  int i;
+  for (i = 0; i <= cm->stridelevels; i++)
+    size *= cm->count[i];
+  vdb_init_rec (&rec, kind, tv, info->localNodeID, tid);
+  rec.u.comm.size = size;
+  rec.u.comm.rnid = info->remoteNodeID;
+  rec.u.comm.typeIndex = cm->typeIndex;
+  rec.u.comm.lineno = cm->lineno;
+  rec.u.comm.fileno = cm->filename;
+  vdb_log (&rec);
+}
+
+static void vdb_log_fork (chpl_vdebug_rec_kind_t kind,
+                          const struct timeval *tv,
+                          const chpl_comm_cb_info_t *info,
+                          chpl_taskID_t tid) {
+  const struct chpl_comm_info_comm_executeOn *cm = &info->iu.executeOn;
+  chpl_vdebug_rec_t rec;
+  vdb_init_rec (&rec, kind, tv, info->localNodeID, tid);
+  rec.u.fork.argSize = (int64_t) cm->arg_size;
+  rec.u.fork.rnid = info->remoteNodeID;
+  rec.u.fork.subloc = cm->subloc;
+  rec.u.fork.fid = cm->fid;
+  vdb_log (&rec);
+}
+
 static int chpl_make_vdebug_file (const char *rootname) {
     char fname[MAXPATHLEN]; 
     struct stat sb;
@@ -118,14 +318,22 @@ static int chpl_make_vdebug_file (const char *rootname) {
 //  nid # -- nodeID
 //  tid # -- taskID
 //  seq time.sec -- unique number for this run
+//
+// In binary files this is the chpl_vdebug_header_t.
 
-void chpl_vdebug_start (const char *fileroot, double now) {
+void chpl_vdebug_start (const char *fileroot, double now, int binary) {
+  static int inited = 0;
   const char * rootname;
   struct rusage ru;
   struct timeval tv;
   chpl_taskID_t startTask = chpl_task_getId();
   (void) gettimeofday (&tv, NULL);
 
+  if (!inited) {
+    CHPL_TLS_INIT(vdb_thread_buf);
+    inited = 1;
+  }
+
   install_callbacks();
 
   chpl_vdebug = 0;
@@ -150,15 +358,60 @@ void chpl_vdebug_start (const char *fileroot, double now) {
     ru.ru_stime.tv_sec = 0;
     ru.ru_stime.tv_usec = 0;
   }
-  chpl_dprintf (chpl_vdebug_fd,
-                "ChplVdebug: ver 1.2 nodes %d nid %d tid %d seq %.3lf %lld.%06ld %ld.%06ld %ld.%06ld \n",
-                chpl_numNodes, chpl_nodeID, (int) startTask, now,
-                (long long) tv.tv_sec, (long) tv.tv_usec,
-                (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
-                (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec  );
+  chpl_vdebug_binary = binary;
+  if (chpl_vdebug_binary) {
+    chpl_vdebug_header_t hdr;
+    memset (&hdr, 0, sizeof (hdr));
+    memcpy (hdr.magic, CHPL_VDEBUG_MAGIC, CHPL_VDEBUG_MAGIC_LEN);
+    hdr.byteOrder = CHPL_VDEBUG_BYTE_ORDER;
+    hdr.verMajor = CHPL_VDEBUG_VER_MAJOR;
+    hdr.verMinor = CHPL_VDEBUG_VER_MINOR;
+    hdr.recSize = sizeof (chpl_vdebug_rec_t);
+    hdr.nodes = chpl_numNodes;
+    hdr.nid = chpl_nodeID;
+    hdr.tid = (int64_t) startTask;
+    hdr.seq = now;
+    hdr.time = vdb_usec (&tv);
+    hdr.utime = vdb_usec (&ru.ru_utime);
+    hdr.stime = vdb_usec (&ru.ru_stime);
+    (void) vdb_write (&hdr, sizeof (hdr));
+  } else {
+    chpl_dprintf (chpl_vdebug_fd,
+                  "ChplVdebug: ver 1.2 nodes %d nid %d tid %d seq %.3lf %lld.%06ld %ld.%06ld %ld.%06ld \n",
+                  chpl_numNodes, chpl_nodeID, (int) startTask, now,
+                  (long long) tv.tv_sec, (long) tv.tv_usec,
+                  (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
+                  (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec  );
+  }
 
   // Dump directory names, file names and function names
-  if (chpl_nodeID == 0) {
+  if (chpl_nodeID == 0 && chpl_vdebug_binary) {
+    chpl_vdebug_rec_t rec;
+    int ix;
+    int numFIDnames;
+
+    for (numFIDnames = 0; chpl_finfo[numFIDnames].name != NULL; numFIDnames++);
+    vdb_init_rec (&rec, chpl_vdebug_rec_tables, NULL, chpl_nodeID, 0);
+    rec.u.tables.fileTblSize = chpl_filenameTableSize;
+    rec.u.tables.funcTblSize = numFIDnames;
+    (void) vdb_write (&rec, sizeof (rec));
+
+    vdb_write_string (chpl_vdebug_rec_chpl_home, 0, 0, 0, CHPL_HOME);
+    vdb_write_string (chpl_vdebug_rec_dir, 0, 0, 0, chpl_compileDirectory);
+    for (ix = 0; ix < chpl_filenameTableSize ; ix++) {
+      if (chpl_filenameTable[ix][0] == 0)
+        vdb_write_string (chpl_vdebug_rec_fname, ix, 0, 0, "<unknown>");
+      else if (chpl_filenameTable[ix][0] == '<' &&
+               chpl_filenameTable[ix][1] == 'c')
+        vdb_write_string (chpl_vdebug_rec_fname, ix, 0, 0, "<command_line>");
+      else
+        vdb_write_string (chpl_vdebug_rec_fname, ix, 0, 0,
+                          chpl_filenameTable[ix]);
+    }
+    for (ix = 0; ix < numFIDnames; ix++)
+      vdb_write_string (chpl_vdebug_rec_fidname, ix, chpl_finfo[ix].lineno,
+                        chpl_finfo[ix].fileno, chpl_finfo[ix].name);
+  } else if (chpl_nodeID == 0) {
     int ix;
     int numFIDnames;
 
@@ -211,12 +464,16 @@ void chpl_vdebug_stop (void) {
       ru.ru_stime.tv_usec = 0;
     }
     // Generate the End record
-    chpl_dprintf (chpl_vdebug_fd, "End: %lld.%06ld %ld.%06ld %ld.%06ld %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
-                  (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
-                  chpl_nodeID, (int) stopTask);
+    if (chpl_vdebug_binary)
+      vdb_write_times (chpl_vdebug_rec_end, &tv, &ru, stopTask, 0);
+    else
+      chpl_dprintf (chpl_vdebug_fd, "End: %lld.%06ld %ld.%06ld %ld.%06ld %d %d\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec,
+                    (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
+                    (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
+                    chpl_nodeID, (int) stopTask);
     close (chpl_vdebug_fd);
+    chpl_vdebug_fd = -1;
   }
 }
 
@@ -230,14 +487,27 @@ void chpl_vdebug_mark (void) {
   struct timeval tv;
   chpl_taskID_t tagTask = chpl_task_getId();
   (void) gettimeofday (&tv, NULL);
-  chpl_dprintf (chpl_vdebug_fd, "VdbMark: %lld.%06ld %d %lu\n",
-                (long long) tv.tv_sec, (long) tv.tv_usec, chpl_nodeID, (unsigned long)tagTask );
+  if (chpl_vdebug_binary) {
+    chpl_vdebug_rec_t rec;
+    if (chpl_vdebug_fd < 0)
+      return;
+    vdb_init_rec (&rec, chpl_vdebug_rec_mark, &tv, chpl_nodeID, tagTask);
+    vdb_log (&rec);
+  } else {
+    chpl_dprintf (chpl_vdebug_fd, "VdbMark: %lld.%06ld %d %lu\n",
+                  (long long) tv.tv_sec, (long) tv.tv_usec, chpl_nodeID, (unsigned long)tagTask );
+  }
 }
 
 // Record>  tname: tag# tagname
 
 void chpl_vdebug_tagname (const char* tagname, int tagno) {
-  chpl_dprintf (chpl_vdebug_fd, "tname: %d %s\n", tagno, tagname);
+  if (chpl_vdebug_binary) {
+    if (chpl_vdebug_fd >= 0)
+      vdb_write_string (chpl_vdebug_rec_tname, tagno, 0, 0, tagname);
+  } else {
+    chpl_dprintf (chpl_vdebug_fd, "tname: %d %s\n", tagno, tagname);
+  }
 }
 
 // Record>  Tag: time.sec user.time sys.time nodeId taskId tag# 
@@ -255,11 +525,17 @@ void chpl_vdebug_tag (int tagno) {
     ru.ru_stime.tv_sec = 0;
     ru.ru_stime.tv_usec = 0;
   }
-  chpl_dprintf (chpl_vdebug_fd, "Tag: %lld.%06ld %ld.%06ld %ld.%06ld %d %d %d\n",
-                (long long) tv.tv_sec, (long) tv.tv_usec,
-                (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
-                (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
-                chpl_nodeID, (int) tagTask, tagno);
+  if (chpl_vdebug_binary) {
+    if (chpl_vdebug_fd < 0)
+      return;
+    vdb_write_times (chpl_vdebug_rec_tag, &tv, &ru, tagTask, tagno);
+  } else {
+    chpl_dprintf (chpl_vdebug_fd, "Tag: %lld.%06ld %ld.%06ld %ld.%06ld %d %d %d\n",
+                  (long long) tv.tv_sec, (long) tv.tv_usec,
+                  (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
+                  (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
+                  chpl_nodeID, (int) tagTask, tagno);
+  }
   chpl_vdebug = 1;
 }
 
@@ -278,11 +554,14 @@ void chpl_vdebug_pause (int tagno) {
       ru.ru_stime.tv_sec = 0;
       ru.ru_stime.tv_usec = 0;
     }
-    chpl_dprintf (chpl_vdebug_fd, "Pause: %lld.%06ld %ld.%06ld %ld.%06ld %d %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
-                  (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
-                  chpl_nodeID, (int) pauseTask, tagno);
+    if (chpl_vdebug_binary)
+      vdb_write_times (chpl_vdebug_rec_pause, &tv, &ru, pauseTask, tagno);
+    else
+      chpl_dprintf (chpl_vdebug_fd, "Pause: %lld.%06ld %ld.%06ld %ld.%06ld %d %d %d\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec,
+                    (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
+                    (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
+                    chpl_nodeID, (int) pauseTask, tagno);
     chpl_vdebug = 0;
   }
 }
@@ -303,12 +582,15 @@ void cb_comm_put_nb (const chpl_comm_cb_info_t *info) {
     const struct chpl_comm_info_comm *cm = &info->iu.comm;
     chpl_taskID_t commTask = chpl_task_getId();
     (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd, 
-                  "nb_put: %lld.%06ld %d %d %lu %#lx %#lx %d %d %d %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID,
-                  info->remoteNodeID, (unsigned long) commTask, (unsigned long) cm->addr,
-                  (unsigned long) cm->raddr, 1, cm->typeIndex, (int)cm->size,
-                  cm->lineno, cm->filename);
+    if (chpl_vdebug_binary)
+      vdb_log_comm (chpl_vdebug_rec_put_nb, &tv, info, commTask);
+    else
+      chpl_dprintf (chpl_vdebug_fd, 
+                    "nb_put: %lld.%06ld %d %d %lu %#lx %#lx %d %d %d %d %d\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID,
+                    info->remoteNodeID, (unsigned long) commTask, (unsigned long) cm->addr,
+                    (unsigned long) cm->raddr, 1, cm->typeIndex, (int)cm->size,
+                    cm->lineno, cm->filename);
   }
 }
 
@@ -323,12 +605,15 @@ void cb_comm_get_nb (const chpl_comm_cb_info_t *info) {
     const struct chpl_comm_info_comm *cm = &info->iu.comm;
     chpl_taskID_t commTask = chpl_task_getId();
     (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  "nb_get: %lld.%06ld %d %d %lu %#lx %#lx %d %d %d %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID,
-                  info->remoteNodeID, (unsigned long)commTask, (unsigned long) cm->addr,
-                  (unsigned long) cm->raddr, 1, cm->typeIndex, (int)cm->size,
-                  cm->lineno, cm->filename);
+    if (chpl_vdebug_binary)
+      vdb_log_comm (chpl_vdebug_rec_get_nb, &tv, info, commTask);
+    else
+      chpl_dprintf (chpl_vdebug_fd,
+                    "nb_get: %lld.%06ld %d %d %lu %#lx %#lx %d %d %d %d %d\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID,
+                    info->remoteNodeID, (unsigned long)commTask, (unsigned long) cm->addr,
+                    (unsigned long) cm->raddr, 1, cm->typeIndex, (int)cm->size,
+                    cm->lineno, cm->filename);
   }
 }
 
@@ -342,12 +627,15 @@ void cb_comm_put (const chpl_comm_cb_info_t *info) {
     const struct chpl_comm_info_comm *cm = &info->iu.comm;
     chpl_taskID_t commTask = chpl_task_getId();
     (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  "put: %lld.%06ld %d %d %lu %#lx %#lx %d %d %d %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
-                  info->remoteNodeID, (unsigned long) commTask, (unsigned long) cm->addr,
-                  (unsigned long) cm->raddr, 1, cm->typeIndex, (int)cm->size,
-                  cm->lineno, cm->filename);
+    if (chpl_vdebug_binary)
+      vdb_log_comm (chpl_vdebug_rec_put, &tv, info, commTask);
+    else
+      chpl_dprintf (chpl_vdebug_fd,
+                    "put: %lld.%06ld %d %d %lu %#lx %#lx %d %d %d %d %d\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
+                    info->remoteNodeID, (unsigned long) commTask, (unsigned long) cm->addr,
+                    (unsigned long) cm->raddr, 1, cm->typeIndex, (int)cm->size,
+                    cm->lineno, cm->filename);
   }
 }
 
@@ -362,12 +650,15 @@ void cb_comm_get (const chpl_comm_cb_info_t *info) {
     const struct chpl_comm_info_comm *cm = &info->iu.comm;
     chpl_taskID_t commTask = chpl_task_getId();
     (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  "get: %lld.%06ld %d %d %lu %#lx %#lx %d %d %d %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID,
-                  info->remoteNodeID, (unsigned long) commTask, (unsigned long) cm->addr,
-                  (unsigned long) cm->raddr, 1, cm->typeIndex, (int)cm->size,
-                  cm->lineno, cm->filename);
+    if (chpl_vdebug_binary)
+      vdb_log_comm (chpl_vdebug_rec_get, &tv, info, commTask);
+    else
+      chpl_dprintf (chpl_vdebug_fd,
+                    "get: %lld.%06ld %d %d %lu %#lx %#lx %d %d %d %d %d\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID,
+                    info->remoteNodeID, (unsigned long) commTask, (unsigned long) cm->addr,
+                    (unsigned long) cm->raddr, 1, cm->typeIndex, (int)cm->size,
+                    cm->lineno, cm->filename);
   }
 }
 
@@ -380,12 +671,15 @@ void cb_comm_put_strd (const chpl_comm_cb_info_t *info) {
     const struct chpl_comm_info_comm_strd *cm = &info->iu.comm_strd;
     chpl_taskID_t commTask = chpl_task_getId();
     (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  "st_put: %lld.%06ld %d %ld %lu %#lx %#lx 1 %zd %d %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID, 
-                  (long) info->remoteNodeID, (unsigned long) commTask,
-                  (unsigned long) cm->srcaddr, (unsigned long) cm->dstaddr, cm->elemSize,
-                  cm->typeIndex, cm->lineno, cm->filename);
+    if (chpl_vdebug_binary)
+      vdb_log_comm_strd (chpl_vdebug_rec_put_strd, &tv, info, commTask);
+    else
+      chpl_dprintf (chpl_vdebug_fd,
+                    "st_put: %lld.%06ld %d %ld %lu %#lx %#lx 1 %zd %d %d %d\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID, 
+                    (long) info->remoteNodeID, (unsigned long) commTask,
+                    (unsigned long) cm->srcaddr, (unsigned long) cm->dstaddr, cm->elemSize,
+                    cm->typeIndex, cm->lineno, cm->filename);
     // printout srcstrides and dststrides and stridelevels and count?
   }
 
@@ -402,12 +696,15 @@ void cb_comm_get_strd (const chpl_comm_cb_info_t *info) {
     const struct chpl_comm_info_comm_strd *cm = &info->iu.comm_strd;
     chpl_taskID_t commTask = chpl_task_getId();
     (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  "st_get: %lld.%06ld %d %ld %lu %#lx %#lx 1 %zd %d %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
-                  (long) info->remoteNodeID, (unsigned long) commTask, 
-                  (unsigned long) cm->dstaddr, (unsigned long) cm->srcaddr, cm->elemSize,
-                  cm->typeIndex, cm->lineno, cm->filename);
+    if (chpl_vdebug_binary)
+      vdb_log_comm_strd (chpl_vdebug_rec_get_strd, &tv, info, commTask);
+    else
+      chpl_dprintf (chpl_vdebug_fd,
+                    "st_get: %lld.%06ld %d %ld %lu %#lx %#lx 1 %zd %d %d %d\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
+                    (long) info->remoteNodeID, (unsigned long) commTask, 
+                    (unsigned long) cm->dstaddr, (unsigned long) cm->srcaddr, cm->elemSize,
+                    cm->typeIndex, cm->lineno, cm->filename);
     // print out the srcstrides and dststrides and stridelevels and count?
   }
 }
@@ -422,11 +719,14 @@ void cb_comm_executeOn (const chpl_comm_cb_info_t *info) {
     chpl_taskID_t executeOnTask = chpl_task_getId();
     struct timeval tv;
     (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  "fork: %lld.%06ld %d %d %d %d %#lx %zd %lu \n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
-                  info->remoteNodeID, cm->subloc, cm->fid, (unsigned long) cm->arg,
-                  cm->arg_size, (unsigned long) executeOnTask);
+    if (chpl_vdebug_binary)
+      vdb_log_fork (chpl_vdebug_rec_fork, &tv, info, executeOnTask);
+    else
+      chpl_dprintf (chpl_vdebug_fd,
+                    "fork: %lld.%06ld %d %d %d %d %#lx %zd %lu \n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
+                    info->remoteNodeID, cm->subloc, cm->fid, (unsigned long) cm->arg,
+                    cm->arg_size, (unsigned long) executeOnTask);
   }
 }
 
@@ -439,10 +739,13 @@ void  cb_comm_executeOn_nb (const chpl_comm_cb_info_t *info) {
     chpl_taskID_t executeOnTask = chpl_task_getId();
     struct timeval tv;
     (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd, "fork_nb: %lld.%06ld %d %d %d %d %#lx %zd %lu\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
-                  info->remoteNodeID, cm->subloc, cm->fid, (unsigned long) cm->arg, 
-                  cm->arg_size, (unsigned long)executeOnTask);
+    if (chpl_vdebug_binary)
+      vdb_log_fork (chpl_vdebug_rec_fork_nb, &tv, info, executeOnTask);
+    else
+      chpl_dprintf (chpl_vdebug_fd, "fork_nb: %lld.%06ld %d %d %d %d %#lx %zd %lu\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
+                    info->remoteNodeID, cm->subloc, cm->fid, (unsigned long) cm->arg, 
+                    cm->arg_size, (unsigned long)executeOnTask);
   }
 }
 
@@ -454,11 +757,14 @@ void cb_comm_executeOn_fast (const chpl_comm_cb_info_t *info) {
     chpl_taskID_t executeOnTask = chpl_task_getId();
     struct timeval tv;
     (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  "f_executeOn: %lld.%06ld %d %d %d %d %#lx %zd %ld\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
-                  info->remoteNodeID, cm->subloc, cm->fid, (unsigned long)cm->arg, 
-                  cm->arg_size, (unsigned long)executeOnTask);
+    if (chpl_vdebug_binary)
+      vdb_log_fork (chpl_vdebug_rec_fork_fast, &tv, info, executeOnTask);
+    else
+      chpl_dprintf (chpl_vdebug_fd,
+                    "f_executeOn: %lld.%06ld %d %d %d %d %#lx %zd %ld\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
+                    info->remoteNodeID, cm->subloc, cm->fid, (unsigned long)cm->arg, 
+                    cm->arg_size, (unsigned long)executeOnTask);
   }
 }
 
@@ -569,14 +875,26 @@ void cb_task_create (const chpl_task_cb_info_t *info) {
     //         (int)info->event_kind, (int)info->nodeID,
     //        (info->iu.full.is_executeOn ? "O" : "L"), taskId, info->iu.full.id);
     (void)gettimeofday(&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd, "task: %lld.%06ld %lld %ld %lu %s %ld %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long long) info->nodeID, (long int) info->iu.full.id,
-                  (unsigned long) taskId,
-                  (info->iu.full.is_executeOn ? "O" : "L"),
-                  (long int) info->iu.full.lineno,
-                  info->iu.full.filename,
-                  info->iu.full.fid);
+    if (chpl_vdebug_binary) {
+      chpl_vdebug_rec_t rec;
+      vdb_init_rec (&rec, chpl_vdebug_rec_task, &tv, info->nodeID,
+                    info->iu.full.id);
+      rec.u.task.ptid = (int64_t) taskId;
+      rec.u.task.isOn = info->iu.full.is_executeOn;
+      rec.u.task.lineno = info->iu.full.lineno;
+      rec.u.task.fileno = info->iu.full.filename;
+      rec.u.task.fid = info->iu.full.fid;
+      vdb_log (&rec);
+    } else {
+      chpl_dprintf (chpl_vdebug_fd, "task: %lld.%06ld %lld %ld %lu %s %ld %d %d\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec,
+                    (long long) info->nodeID, (long int) info->iu.full.id,
+                    (unsigned long) taskId,
+                    (info->iu.full.is_executeOn ? "O" : "L"),
+                    (long int) info->iu.full.lineno,
+                    info->iu.full.filename,
+                    info->iu.full.fid);
+    }
    }
 }
 
@@ -587,9 +905,16 @@ void cb_task_begin (const chpl_task_cb_info_t *info) {
   if (!chpl_vdebug) return;
   if (chpl_vdebug_fd >= 0) {
     (void)gettimeofday(&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd, "Btask: %lld.%06ld %lld %lu\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long long) info->nodeID, (unsigned long) info->iu.full.id);
+    if (chpl_vdebug_binary) {
+      chpl_vdebug_rec_t rec;
+      vdb_init_rec (&rec, chpl_vdebug_rec_btask, &tv, info->nodeID,
+                    info->iu.full.id);
+      vdb_log (&rec);
+    } else {
+      chpl_dprintf (chpl_vdebug_fd, "Btask: %lld.%06ld %lld %lu\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec,
+                    (long long) info->nodeID, (unsigned long) info->iu.full.id);
+    }
  
   }
 }
@@ -601,9 +926,16 @@ void cb_task_end (const chpl_task_cb_info_t *info) {
   if (!chpl_vdebug) return;
   if (chpl_vdebug_fd >= 0) {
     (void)gettimeofday(&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd, "Etask: %lld.%06ld %lld %lu\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long long) info->nodeID, (unsigned long) info->iu.id_only.id);
+    if (chpl_vdebug_binary) {
+      chpl_vdebug_rec_t rec;
+      vdb_init_rec (&rec, chpl_vdebug_rec_etask, &tv, info->nodeID,
+                    info->iu.id_only.id);
+      vdb_log (&rec);
+    } else {
+      chpl_dprintf (chpl_vdebug_fd, "Etask: %lld.%06ld %lld %lu\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec,
+                    (long long) info->nodeID, (unsigned long) info->iu.id_only.id);
+    }
  
   }
 }
@@ -20,6 +20,7 @@
 #include "chplrt.h"
 
 #include "chplmemtrack.h"
+#include "chpl-atomics.h"
 #include "chpl-mem.h"
 #include "chpl-mem-desc.h"
 #include "chpl-tasks.h"
@@ -79,10 +80,41 @@ static int hashSizes[NUM_HASH_SIZE_INDICES] = { 1543, 3079, 6151, 12289, 24593,
                                                 196613, 393241, 786433, 1572869, 3145739,
                                                 6291469, 12582917, 25165843, 50331653,
                                                 100663319, 201326611, 402653189, 805306457 };
-static int hashSizeIndex = 0;
-static int hashSize = 0;
 
-static memTableEntry** memTable = NULL;
+//
+// The table of tracked allocations is split into shards selected by a hash
+// of the allocation's address, each with its own lock, hash table and
+// allocation counters, so that concurrent tasks rarely contend.  The
+// counters of the shards are only summed when they are reported.  The
+// current and maximum memory in use have to be global to check memMax and
+// find the high-water mark, so they are kept in lock-free atomics.
+//
+#define NUM_MEM_TABLE_SHARDS 64
+
+typedef struct {
+  chpl_sync_aux_t sync;
+  memTableEntry** table;
+  int hashSizeIndex;
+  int hashSize;
+  size_t numEntries;
+} memTableShard;
+
+// pad each shard to its own cache lines
+typedef union {
+  memTableShard s;
+  char pad[((sizeof(memTableShard) + 63) / 64) * 64];
+} memTableShardPadded;
+
+static memTableShardPadded memTable[NUM_MEM_TABLE_SHARDS];
+
+typedef struct {
+  size_t allocated; /* total memory allocated through this shard */
+  size_t freed;     /* total memory freed through this shard */
+  char pad[64 - 2 * sizeof(size_t)];
+} memShardStats;
+
+// Not in memTableShard so that other locales can GET all of these at once
+static memShardStats shardStats[NUM_MEM_TABLE_SHARDS];
 
 static _Bool memStats = false;
 static _Bool memLeaksByType = false;
@@ -94,13 +126,8 @@ static c_string memLog = NULL;
 static FILE* memLogFile = NULL;
 static c_string memLeaksLog = NULL;
 
-static size_t totalMem = 0;       /* total memory currently allocated */
-static size_t maxMem = 0;         /* maximum total memory during run  */
-static size_t totalAllocated = 0; /* total memory allocated */
-static size_t totalFreed = 0;     /* total memory freed */
-static size_t totalEntries = 0;     /* number of entries in hash table */
-
-static chpl_sync_aux_t memTrack_sync;
+static atomic_uint_least64_t totalMem; /* total memory currently allocated */
+static atomic_uint_least64_t maxMem;   /* maximum total memory during run  */
 
 
 void chpl_setMemFlags(void) {
@@ -155,14 +182,28 @@ void chpl_setMemFlags(void) {
   }
 
   if (chpl_memTrack) {
-    chpl_sync_initAux(&memTrack_sync);
-    hashSizeIndex = 0;
-    hashSize = hashSizes[hashSizeIndex];
-    memTable = calloc(hashSize, sizeof(memTableEntry*));
+    int i;
+    atomic_init_uint_least64_t(&totalMem, 0);
+    atomic_init_uint_least64_t(&maxMem, 0);
+    for (i = 0; i < NUM_MEM_TABLE_SHARDS; i++) {
+      memTableShard* shard = &memTable[i].s;
+      chpl_sync_initAux(&shard->sync);
+      shard->hashSizeIndex = 0;
+      shard->hashSize = hashSizes[shard->hashSizeIndex];
+      shard->table = calloc(shard->hashSize, sizeof(memTableEntry*));
+      shard->numEntries = 0;
+    }
   }
 }
 
 
+static int shardIndex(void* memAlloc) {
+  // allocations are aligned, so drop the low bits before mixing
+  uint64_t a = ((uint64_t)(uintptr_t)memAlloc >> 4) * UINT64_C(0x9e3779b97f4a7c15);
+  return (int)((a >> 32) % NUM_MEM_TABLE_SHARDS);
+}
+
+
 static unsigned hash(void* memAlloc, int hashSize) {
   unsigned hashValue = 0;
   char* fakeCharPtr = (char*)&memAlloc;
@@ -175,37 +216,43 @@ static unsigned hash(void* memAlloc, int hashSize) {
 }
 
 
-static void increaseMemStat(size_t chunk, int32_t lineno, int32_t filename) {
-  totalMem += chunk;
-  totalAllocated += chunk;
-  if (memMax && (totalMem > memMax)) {
+static void increaseMemStat(int shardNum, size_t chunk,
+                            int32_t lineno, int32_t filename) {
+  uint64_t newTotal = atomic_fetch_add_uint_least64_t(&totalMem, chunk) + chunk;
+  uint64_t oldMax;
+
+  shardStats[shardNum].allocated += chunk;
+  if (memMax && (newTotal > memMax)) {
     chpl_error("Exceeded memory limit", lineno, filename);
   }
-  if (totalMem > maxMem)
-    maxMem = totalMem;
+  oldMax = atomic_load_uint_least64_t(&maxMem);
+  while (newTotal > oldMax &&
+         !atomic_compare_exchange_strong_uint_least64_t(&maxMem,
+                                                        oldMax, newTotal))
+    oldMax = atomic_load_uint_least64_t(&maxMem);
 }
 
 
-static void decreaseMemStat(size_t chunk) {
-  totalMem -= chunk; // > totalMem ? 0 : totalMem - chunk;
-  totalFreed += chunk;
+static void decreaseMemStat(int shardNum, size_t chunk) {
+  atomic_fetch_sub_uint_least64_t(&totalMem, chunk);
+  shardStats[shardNum].freed += chunk;
 }
 
 
 static void
-resizeTable(int direction) {
+resizeTable(memTableShard* shard, int direction) {
   memTableEntry** newMemTable = NULL;
   int newHashSizeIndex, newHashSize, newHashValue;
   int i;
   memTableEntry* me;
   memTableEntry* next;
 
-  newHashSizeIndex = hashSizeIndex + direction;
+  newHashSizeIndex = shard->hashSizeIndex + direction;
   newHashSize = hashSizes[newHashSizeIndex];
   newMemTable = calloc(newHashSize, sizeof(memTableEntry*));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = next) {
+  for (i = 0; i < shard->hashSize; i++) {
+    for (me = shard->table[i]; me != NULL; me = next) {
       next = me->nextInBucket;
       newHashValue = hash(me->memAlloc, newHashSize);
       me->nextInBucket = newMemTable[newHashValue];
@@ -213,54 +260,70 @@ resizeTable(int direction) {
     }
   }
 
-  free(memTable);
-  memTable = newMemTable;
-  hashSize = newHashSize;
-  hashSizeIndex = newHashSizeIndex;
+  free(shard->table);
+  shard->table = newMemTable;
+  shard->hashSize = newHashSize;
+  shard->hashSizeIndex = newHashSizeIndex;
 }
 
 static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
                              chpl_mem_descInt_t description, int32_t lineno,
                              int32_t filename) {
+  const int shardNum = shardIndex(memAlloc);
+  memTableShard* shard = &memTable[shardNum].s;
   unsigned hashValue;
   memTableEntry* memEntry;
 
-  if ((totalEntries+1)*2 > hashSize && hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
-    resizeTable(1);
-
   memEntry = (memTableEntry*) calloc(1, sizeof(memTableEntry));
   if (!memEntry) {
     chpl_error("memtrack fault: out of memory allocating memtrack table",
                lineno, filename);
   }
-
-  hashValue = hash(memAlloc, hashSize);
-  memEntry->nextInBucket = memTable[hashValue];
-  memTable[hashValue] = memEntry;
   memEntry->description = description;
   memEntry->memAlloc = memAlloc;
   memEntry->lineno = lineno;
   memEntry->filename = filename;
   memEntry->number = number;
   memEntry->size = size;
-  increaseMemStat(number*size, lineno, filename);
-  totalEntries += 1;
+
+  chpl_sync_lock(&shard->sync);
+
+  if ((shard->numEntries+1)*2 > shard->hashSize &&
+      shard->hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
+    resizeTable(shard, 1);
+
+  hashValue = hash(memAlloc, shard->hashSize);
+  memEntry->nextInBucket = shard->table[hashValue];
+  shard->table[hashValue] = memEntry;
+  shard->numEntries += 1;
+  increaseMemStat(shardNum, number*size, lineno, filename);
+
+  chpl_sync_unlock(&shard->sync);
 }
 
 
 static memTableEntry* removeMemTableEntry(void* address) {
-  unsigned hashValue = hash(address, hashSize);
-  memTableEntry* thisBucketEntry = memTable[hashValue];
+  const int shardNum = shardIndex(address);
+  memTableShard* shard = &memTable[shardNum].s;
+  unsigned hashValue;
+  memTableEntry* thisBucketEntry;
   memTableEntry* deletedBucket = NULL;
 
-  if (!thisBucketEntry)
+  chpl_sync_lock(&shard->sync);
+
+  hashValue = hash(address, shard->hashSize);
+  thisBucketEntry = shard->table[hashValue];
+
+  if (!thisBucketEntry) {
+    chpl_sync_unlock(&shard->sync);
     return NULL;
+  }
 
   if (thisBucketEntry->memAlloc == address) {
-    memTable[hashValue] = thisBucketEntry->nextInBucket;
+    shard->table[hashValue] = thisBucketEntry->nextInBucket;
     deletedBucket = thisBucketEntry;
   } else {
-    for (thisBucketEntry = memTable[hashValue];
+    for (thisBucketEntry = shard->table[hashValue];
          thisBucketEntry != NULL;
          thisBucketEntry = thisBucketEntry->nextInBucket) {
 
@@ -273,15 +336,30 @@ static memTableEntry* removeMemTableEntry(void* address) {
     }
   }
   if (deletedBucket) {
-    decreaseMemStat(deletedBucket->number * deletedBucket->size);
-    totalEntries -= 1;
-    if (totalEntries*8 < hashSize && hashSizeIndex > 0)
-      resizeTable(-1);
+    decreaseMemStat(shardNum, deletedBucket->number * deletedBucket->size);
+    shard->numEntries -= 1;
+    if (shard->numEntries*8 < shard->hashSize && shard->hashSizeIndex > 0)
+      resizeTable(shard, -1);
   }
+
+  chpl_sync_unlock(&shard->sync);
   return deletedBucket;
 }
 
 
+// Sum the allocated and freed counters of a set of shards
+static void sumShardStats(memShardStats* stats,
+                          size_t* allocated, size_t* freed) {
+  int i;
+  *allocated = 0;
+  *freed = 0;
+  for (i = 0; i < NUM_MEM_TABLE_SHARDS; i++) {
+    *allocated += stats[i].allocated;
+    *freed += stats[i].freed;
+  }
+}
+
+
 uint64_t chpl_memoryUsed(int32_t lineno, int32_t filename) {
   if (!chpl_memTrack) {
     chpl_warning("invalid call to memoryUsed(); rerun with --memTrack",
@@ -289,7 +367,7 @@ uint64_t chpl_memoryUsed(int32_t lineno, int32_t filename) {
     return 0;
   }
 
-  return (uint64_t)totalMem;
+  return (uint64_t)atomic_load_uint_least64_t(&totalMem);
 }
 
 
@@ -300,13 +378,16 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
     return;
   }
 
-  chpl_sync_lock(&memTrack_sync);
   fprintf(memLogFile, "=================\n");
   fprintf(memLogFile, "Memory Statistics\n");
   if (chpl_numNodes == 1) {
+    size_t totalAllocated, totalFreed;
+    sumShardStats(shardStats, &totalAllocated, &totalFreed);
     fprintf(memLogFile, "==============================================================\n");
-    fprintf(memLogFile, "Current Allocated Memory               %zd\n", totalMem);
-    fprintf(memLogFile, "Maximum Simultaneous Allocated Memory  %zd\n", maxMem);
+    fprintf(memLogFile, "Current Allocated Memory               %zd\n",
+            (size_t)atomic_load_uint_least64_t(&totalMem));
+    fprintf(memLogFile, "Maximum Simultaneous Allocated Memory  %zd\n",
+            (size_t)atomic_load_uint_least64_t(&maxMem));
     fprintf(memLogFile, "Total Allocated Memory                 %zd\n", totalAllocated);
     fprintf(memLogFile, "Total Freed Memory                     %zd\n", totalFreed);
     fprintf(memLogFile, "==============================================================\n");
@@ -320,16 +401,18 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
     fprintf(memLogFile, "                                            Total Freed Memory\n");
     fprintf(memLogFile, "==============================================================\n");
     for (i = 0; i < chpl_numNodes; i++) {
-      static size_t m1, m2, m3, m4;
-      chpl_gen_comm_get(&m1, i, &totalMem, sizeof(size_t), -1 /* broke for hetero */, lineno, filename);
-      chpl_gen_comm_get(&m2, i, &maxMem, sizeof(size_t), -1 /* broke for hetero */, lineno, filename);
-      chpl_gen_comm_get(&m3, i, &totalAllocated,  sizeof(size_t), -1 /* broke for hetero */, lineno, filename);
-      chpl_gen_comm_get(&m4, i, &totalFreed, sizeof(size_t), -1 /*broke for hetero */, lineno, filename);
-      fprintf(memLogFile, "%-9d  %-9zu  %-9zu  %-9zu  %-9zu\n", i, m1, m2, m3, m4);
+      static uint64_t m1, m2;
+      static size_t m3, m4;
+      static memShardStats stats[NUM_MEM_TABLE_SHARDS];
+      chpl_gen_comm_get(&m1, i, &totalMem, sizeof(uint64_t), -1 /* broke for hetero */, lineno, filename);
+      chpl_gen_comm_get(&m2, i, &maxMem, sizeof(uint64_t), -1 /* broke for hetero */, lineno, filename);
+      chpl_gen_comm_get(stats, i, shardStats, sizeof(shardStats), -1 /* broke for hetero */, lineno, filename);
+      sumShardStats(stats, &m3, &m4);
+      fprintf(memLogFile, "%-9d  %-9zu  %-9zu  %-9zu  %-9zu\n", i,
+              (size_t)m1, (size_t)m2, m3, m4);
     }
     fprintf(memLogFile, "==============================================================\n");
   }
-  chpl_sync_unlock(&memTrack_sync);
 }
 
 
@@ -343,7 +426,7 @@ static void printMemAllocsByType(_Bool forLeaks,
                                  int32_t lineno, int32_t filename) {
   size_t* table;
   memTableEntry* me;
-  int i;
+  int s, i;
   const int numberWidth   = 9;
   const int numEntries = CHPL_RT_MD_NUM+chpl_mem_numDescs;
 
@@ -356,11 +439,14 @@ static void printMemAllocsByType(_Bool forLeaks,
 
   table = (size_t*)calloc(numEntries, 3*sizeof(size_t));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = me->nextInBucket) {
-      table[3*me->description] += me->number*me->size;
-      table[3*me->description+1] += 1;
-      table[3*me->description+2] = me->description;
+  for (s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memTable[s].s;
+    for (i = 0; i < shard->hashSize; i++) {
+      for (me = shard->table[i]; me != NULL; me = me->nextInBucket) {
+        table[3*me->description] += me->number*me->size;
+        table[3*me->description+1] += 1;
+        table[3*me->description+2] = me->description;
+      }
     }
   }
 
@@ -462,7 +548,7 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
 
   memTableEntry* memEntry;
   c_string memEntryFilename;
-  int n, i;
+  int n, s, i;
   char* loc;
   memTableEntry** table;
 
@@ -474,19 +560,22 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
 
   n = 0;
   filenameWidth = strlen("Allocated Memory (Bytes)");
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      n += 1;
-      if (memEntry->filename) {
-        memEntryFilename = chpl_lookupFilename(memEntry->filename);
-        filenameLength = strlen(memEntryFilename);
-        if (filenameLength > filenameWidth)
-          filenameWidth = filenameLength;
+  for (s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memTable[s].s;
+    for (i = 0; i < shard->hashSize; i++) {
+      for (memEntry = shard->table[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        n += 1;
+        if (memEntry->filename) {
+          memEntryFilename = chpl_lookupFilename(memEntry->filename);
+          filenameLength = strlen(memEntryFilename);
+          if (filenameLength > filenameWidth)
+            filenameWidth = filenameLength;
+        }
       }
     }
   }
@@ -511,14 +600,17 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
     chpl_error("out of memory printing memory table", lineno, filename);
 
   n = 0;
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      table[n++] = memEntry;
+  for (s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memTable[s].s;
+    for (i = 0; i < shard->hashSize; i++) {
+      for (memEntry = shard->table[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        table[n++] = memEntry;
+      }
     }
   }
   qsort(table, n, sizeof(memTableEntry*), descCmp);
@@ -587,9 +679,7 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
                        int32_t lineno, int32_t filename) {
   if (number * size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      chpl_sync_lock(&memTrack_sync);
       addMemTableEntry(memAlloc, number, size, description, lineno, filename);
-      chpl_sync_unlock(&memTrack_sync);
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" FORMAT_c_nodeid_t ": %s:%" PRId32
@@ -605,7 +695,6 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
 void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
   memTableEntry* memEntry = NULL;
   if (chpl_memTrack) {
-    chpl_sync_lock(&memTrack_sync);
     memEntry = removeMemTableEntry(memAlloc);
     if (memEntry) {
       if (chpl_verbose_mem) {
@@ -617,7 +706,6 @@ void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
       }
       free(memEntry);
     }
-    chpl_sync_unlock(&memTrack_sync);
   } else if (chpl_verbose_mem && !memEntry) {
     fprintf(memLogFile, "%" FORMAT_c_nodeid_t ": %s:%" PRId32 ": free at %p\n",
             chpl_nodeID, (filename ? chpl_lookupFilename(filename) : "--"),
@@ -632,13 +720,11 @@ void chpl_track_realloc_pre(void* memAlloc, size_t size,
   memTableEntry* memEntry = NULL;
 
   if (chpl_memTrack && size > memThreshold) {
-    chpl_sync_lock(&memTrack_sync);
     if (memAlloc) {
       memEntry = removeMemTableEntry(memAlloc);
       if (memEntry)
         free(memEntry);
     }
-    chpl_sync_unlock(&memTrack_sync);
   }
 }
 
@@ -649,9 +735,7 @@ void chpl_track_realloc_post(void* moreMemAlloc,
                          int32_t lineno, int32_t filename) {
   if (size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      chpl_sync_lock(&memTrack_sync);
       addMemTableEntry(moreMemAlloc, 1, size, description, lineno, filename);
-      chpl_sync_unlock(&memTrack_sync);
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" FORMAT_c_nodeid_t ": %s:%" PRId32
@@ -248,7 +248,9 @@ typedef enum {
   EXIT_ANY,             // <unused> to be used for exit_any() cleanup
   BCAST_SEGINFO,        // broadcast for segment info table
   DO_REPLY_PUT,         // do a PUT here from another locale
-  DO_COPY_PAYLOAD       // copy AM payload to another address
+  DO_COPY_PAYLOAD,      // copy AM payload to another address
+  DO_AGGREGATE,         // apply a buffer of aggregated updates
+  AGG_ACK               // ack to an aggregator via gasnet_AMReplyShortM()
 } AM_handler_function_idx_t;
 
 static void AM_fork_fast(gasnet_token_t token, void* buf, size_t nbytes) {
@@ -574,6 +576,21 @@ void AM_copy_payload(gasnet_token_t token, void* buf, size_t nbytes,
   GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL, ack0, ack1));
 }
 
+// Apply the aggregated updates in the payload of this active message.
+static
+void AM_aggregate(gasnet_token_t token, void* buf, size_t nbytes,
+                  gasnet_handlerarg_t ack0, gasnet_handlerarg_t ack1)
+{
+  chpl_comm_agg_apply(buf, nbytes);
+
+  GASNET_Safe(gasnet_AMReplyShort2(token, AGG_ACK, ack0, ack1));
+}
+
+static void AM_agg_ack(gasnet_token_t token,
+                       gasnet_handlerarg_t a0, gasnet_handlerarg_t a1) {
+  chpl_comm_agg_ack(get_ptr_from_args(a0, a1));
+}
+
 static gasnet_handlerentry_t ftable[] = {
   {FORK,          AM_fork},
   {FORK_SMALL,    AM_fork_small},
@@ -591,7 +608,9 @@ static gasnet_handlerentry_t ftable[] = {
   {EXIT_ANY,      AM_exit_any},
   {BCAST_SEGINFO, AM_bcast_seginfo},
   {DO_REPLY_PUT,  AM_reply_put},
-  {DO_COPY_PAYLOAD, AM_copy_payload}
+  {DO_COPY_PAYLOAD, AM_copy_payload},
+  {DO_AGGREGATE,  AM_aggregate},
+  {AGG_ACK,       AM_agg_ack}
 };
 
 //
@@ -630,6 +649,7 @@ chpl_comm_nb_handle_t chpl_comm_put_nb(void *addr, c_nodeid_t node, void* raddr,
     chpl_sync_lock(&chpl_comm_diagnostics_sync);
     chpl_comm_commDiagnostics.put_nb++;
     chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+    chpl_comm_diags_count(chpl_comm_diags_put_nb, node, size);
   }
 
   return (chpl_comm_nb_handle_t) ret;
@@ -668,6 +688,7 @@ chpl_comm_nb_handle_t chpl_comm_get_nb(void* addr, c_nodeid_t node, void* raddr,
     chpl_sync_lock(&chpl_comm_diagnostics_sync);
     chpl_comm_commDiagnostics.get_nb++;
     chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+    chpl_comm_diags_count(chpl_comm_diags_get_nb, node, size);
   }
 
   return (chpl_comm_nb_handle_t) ret;
@@ -863,7 +884,9 @@ void chpl_comm_init(int *argc_p, char ***argv_p) {
 
 }
 
-void chpl_comm_post_mem_init(void) { }
+void chpl_comm_post_mem_init(void) {
+  chpl_comm_diags_init();
+}
 
 int chpl_comm_numPollingTasks(void) {
   return 1;
@@ -1085,6 +1108,7 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
                     size_t size, int32_t typeIndex,
                     int ln, int32_t fn) {
   int remote_in_segment;
+  uint64_t diags_start = 0;
 
   if (chpl_nodeID == node) {
     memmove(raddr, addr, size);
@@ -1104,6 +1128,8 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
       chpl_sync_lock(&chpl_comm_diagnostics_sync);
       chpl_comm_commDiagnostics.put++;
       chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+      chpl_comm_diags_count(chpl_comm_diags_put, node, size);
+      diags_start = chpl_comm_diags_time();
     }
 
     // Handle remote address not in remote segment.
@@ -1157,6 +1183,9 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
         wait_done_obj(&done);
       }
     }
+
+    if (diags_start != 0)
+      chpl_comm_diags_latency(chpl_comm_diags_put, diags_start);
   }
 }
 
@@ -1167,6 +1196,7 @@ void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
                     size_t size, int32_t typeIndex,
                     int ln, int32_t fn) {
   int remote_in_segment;
+  uint64_t diags_start = 0;
 
   if (chpl_nodeID == node) {
     memmove(addr, raddr, size);
@@ -1186,6 +1216,8 @@ void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
       chpl_sync_lock(&chpl_comm_diagnostics_sync);
       chpl_comm_commDiagnostics.get++;
       chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+      chpl_comm_diags_count(chpl_comm_diags_get, node, size);
+      diags_start = chpl_comm_diags_time();
     }
 
     // Handle remote address not in remote segment.
@@ -1284,6 +1316,9 @@ void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
         chpl_mem_free(local_buf, 0, 0);
       }
     }
+
+    if (diags_start != 0)
+      chpl_comm_diags_latency(chpl_comm_diags_get, diags_start);
   }
 }
 
@@ -1299,6 +1334,7 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode_i
   int i;
   const size_t strlvls = (size_t)stridelevels;
   const gasnet_node_t srcnode = (gasnet_node_t)srcnode_id;
+  uint64_t diags_start = 0;
 
   size_t dststr[strlvls];
   size_t srcstr[strlvls];
@@ -1349,13 +1385,23 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode_i
     printf("%d: %s:%d: remote get from %d\n", chpl_nodeID,
            chpl_lookupFilename(fn), ln, srcnode);
   if (chpl_comm_diagnostics && !chpl_comm_no_debug_private) {
+    size_t bytes = cnt[0];
+
+    for (i = 1; i <= strlvls; i++)
+      bytes *= cnt[i];
+
     chpl_sync_lock(&chpl_comm_diagnostics_sync);
     chpl_comm_commDiagnostics.get++;
     chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+    chpl_comm_diags_count(chpl_comm_diags_get, srcnode, bytes);
+    diags_start = chpl_comm_diags_time();
   }
 
   // TODO -- handle strided get for non-registered memory
   gasnet_gets_bulk(dstaddr, dststr, srcnode, srcaddr, srcstr, cnt, strlvls); 
+
+  if (diags_start != 0)
+    chpl_comm_diags_latency(chpl_comm_diags_get, diags_start);
 }
 
 // See the comment for chpl_comm_gets().
@@ -1366,6 +1412,7 @@ void  chpl_comm_put_strd(void* dstaddr, size_t* dststrides, c_nodeid_t dstnode_i
   int i;
   const size_t strlvls = (size_t)stridelevels;
   const gasnet_node_t dstnode = (gasnet_node_t)dstnode_id;
+  uint64_t diags_start = 0;
 
   size_t dststr[strlvls];
   size_t srcstr[strlvls];
@@ -1414,12 +1461,22 @@ void  chpl_comm_put_strd(void* dstaddr, size_t* dststrides, c_nodeid_t dstnode_i
     printf("%d: %s:%d: remote get from %d\n", chpl_nodeID,
            chpl_lookupFilename(fn), ln, dstnode);
   if (chpl_comm_diagnostics && !chpl_comm_no_debug_private) {
+    size_t bytes = cnt[0];
+
+    for (i = 1; i <= strlvls; i++)
+      bytes *= cnt[i];
+
     chpl_sync_lock(&chpl_comm_diagnostics_sync);
     chpl_comm_commDiagnostics.put++;
     chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+    chpl_comm_diags_count(chpl_comm_diags_put, dstnode, bytes);
+    diags_start = chpl_comm_diags_time();
   }
   // TODO -- handle strided put for non-registered memory
   gasnet_puts_bulk(dstnode, dstaddr, dststr, srcaddr, srcstr, cnt, strlvls); 
+
+  if (diags_start != 0)
+    chpl_comm_diags_latency(chpl_comm_diags_put, diags_start);
 }
 
 static inline
@@ -1541,6 +1598,7 @@ void  chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
                      chpl_fn_int_t fid,
                      chpl_comm_on_bundle_t *arg, size_t arg_size) {
   done_t  done;
+  uint64_t diags_start = 0;
 
   if (chpl_nodeID == node) {
     assert(0);
@@ -1560,10 +1618,15 @@ void  chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
       chpl_sync_lock(&chpl_comm_diagnostics_sync);
       chpl_comm_commDiagnostics.execute_on++;
       chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+      chpl_comm_diags_count(chpl_comm_diags_execute_on, node, arg_size);
+      diags_start = chpl_comm_diags_time();
     }
 
     execute_on_common(node, subloc, fid, arg, arg_size,
                      /*fast*/ false, /*blocking*/ true);
+
+    if (diags_start != 0)
+      chpl_comm_diags_latency(chpl_comm_diags_execute_on, diags_start);
   }
 }
 
@@ -1598,6 +1661,7 @@ void  chpl_comm_execute_on_nb(c_nodeid_t node, c_sublocid_t subloc,
       chpl_sync_lock(&chpl_comm_diagnostics_sync);
       chpl_comm_commDiagnostics.execute_on_nb++;
       chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+      chpl_comm_diags_count(chpl_comm_diags_execute_on_nb, node, arg_size);
     }
   
     execute_on_common(node, subloc, fid, arg, arg_size,
@@ -1610,6 +1674,7 @@ void  chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
                           chpl_fn_int_t fid,
                           chpl_comm_on_bundle_t *arg, size_t arg_size) {
   done_t  done;
+  uint64_t diags_start = 0;
 
   if (chpl_nodeID == node) {
     assert(0);
@@ -1630,13 +1695,31 @@ void  chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
       chpl_sync_lock(&chpl_comm_diagnostics_sync);
       chpl_comm_commDiagnostics.execute_on_fast++;
       chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+      chpl_comm_diags_count(chpl_comm_diags_execute_on_fast, node, arg_size);
+      diags_start = chpl_comm_diags_time();
     }
 
   execute_on_common(node, subloc, fid, arg, arg_size,
                     /*fast*/ true, /*blocking*/ true);
+
+    if (diags_start != 0)
+      chpl_comm_diags_latency(chpl_comm_diags_execute_on_fast, diags_start);
   }
 }
 
+size_t chpl_comm_agg_max_msg_size(void) {
+  return gasnet_AMMaxMedium();
+}
+
+void chpl_comm_agg_send(c_nodeid_t node, void* buf, size_t size, void* ack) {
+  if (chpl_verbose_comm && !chpl_comm_no_debug_private)
+    printf("%d: remote aggregated update of %zd bytes sent to %d\n",
+           chpl_nodeID, size, node);
+
+  GASNET_Safe(gasnet_AMRequestMedium2(node, DO_AGGREGATE, buf, size,
+                                      Arg0(ack), Arg1(ack)));
+}
+
 void chpl_comm_make_progress(void)
 {
   gasnet_AMPoll();
@@ -1695,6 +1778,7 @@ void chpl_resetCommDiagnosticsHere() {
   chpl_sync_lock(&chpl_comm_diagnostics_sync);
   memset(&chpl_comm_commDiagnostics, 0, sizeof(chpl_commDiagnostics));
   chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+  chpl_comm_diags_reset();
 }
 
 void chpl_getCommDiagnosticsHere(chpl_commDiagnostics *cd) {
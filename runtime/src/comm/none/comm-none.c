@@ -109,7 +109,9 @@ void chpl_comm_init(int *argc_p, char ***argv_p) {
   chpl_nodeID = 0;
 }
 
-void chpl_comm_post_mem_init(void) { }
+void chpl_comm_post_mem_init(void) {
+  chpl_comm_diags_init();
+}
 
 int chpl_comm_run_in_gdb(int argc, char* argv[], int gdbArgnum, int* status) {
   int i;
@@ -502,6 +504,17 @@ void chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
   chpl_ftable_call(fid, arg);
 }
 
+size_t chpl_comm_agg_max_msg_size(void) {
+  return SIZE_MAX;
+}
+
+void chpl_comm_agg_send(c_nodeid_t node, void* buf, size_t size, void* ack) {
+  assert(node==0);
+
+  chpl_comm_agg_apply(buf, size);
+  chpl_comm_agg_ack(ack);
+}
+
 int chpl_comm_numPollingTasks(void) { return 0; }
 
 void chpl_comm_make_progress(void)
@@ -518,7 +531,9 @@ void chpl_stopCommDiagnostics() { }
 void chpl_startCommDiagnosticsHere() { }
 void chpl_stopCommDiagnosticsHere() { }
 
-void chpl_resetCommDiagnosticsHere() { }
+void chpl_resetCommDiagnosticsHere() {
+  chpl_comm_diags_reset();
+}
 void chpl_getCommDiagnosticsHere(chpl_commDiagnostics *cd) {
   memset(cd, 0, sizeof(chpl_commDiagnostics));
 }
@@ -72,6 +72,15 @@ const char* qio_regexp_error(const qio_regexp_t* regexp)
   return qio_strdup("No Regexp Support");
 }
 
+void qio_regexp_get_cache_stats(qio_regexp_cache_stats_t* stats)
+{
+  memset(stats, 0, sizeof(*stats));
+}
+
+void qio_regexp_reset_cache_stats(void)
+{
+}
+
 bool qio_regexp_match(qio_regexp_t* regexp, const char* text, int64_t str_len, int64_t startpos, int64_t endpos, int anchor, qio_regexp_string_piece_t* submatch, int64_t nsubmatch)
 {
   chpl_internal_error("No Regexp Support");
@@ -6,11 +6,17 @@
 
 #include <limits>
 #include <algorithm>
+#include <unordered_map>
 #include <pthread.h>
+#include <inttypes.h>
 
   #include <stdlib.h>
   #include <stdio.h>
 #ifndef CHPL_RT_UNIT_TEST
+extern "C" {
+  #include "chpl-env.h" // for the cache size
+  #include "error.h"
+}
   #include "stdchplrt.h"
 #endif
   #include "qio_regexp.h"
@@ -23,14 +29,12 @@
 
 using namespace re2;
 
-struct re_cache;
-
 struct re_t {
   RE2 re;
   qbytes_refcnt_t ref_cnt;
   // RE2 implementations are shared and ref-counted.
   // We free the internal RE2 once ref_cnt==0.
-  re_t(StringPiece& pattern, const RE2::Options& option, re_cache* home)
+  re_t(StringPiece& pattern, const RE2::Options& option)
     : re(pattern, option)
   {
     // Initialize the reference count to 1.
@@ -39,37 +43,69 @@ struct re_t {
   }
 };
 
-// A very simple 8-element local regexp cache.
-#define REGEXP_CACHE_SIZE 8
+// A process-wide cache of compiled regular expressions, shared by all
+// threads.  Lookups only take the lock for reading, and patterns are
+// compiled outside of the lock.  When the cache is full, a CLOCK sweep
+// evicts an entry that has not been used since the hand last passed it.
+// The capacity can be set with CHPL_RT_REGEXP_CACHE_SIZE; 0 disables the
+// cache.
+#define REGEXP_CACHE_DEFAULT_SIZE 64
+
 struct cache_elem {
-  int64_t date;
   re_t* re;
+  uint64_t hash;
+  volatile int used;
 };
 
 struct re_cache {
-  int64_t date;
-  cache_elem elems[REGEXP_CACHE_SIZE];
+  pthread_rwlock_t lock;
+  int64_t capacity;
+  int64_t hand;
+  int64_t nentries;
+  cache_elem* elems;
+  // maps the hash of a pattern and its options to a slot in elems
+  std::unordered_multimap<uint64_t, int64_t> index;
+  atomic_uint_least64_t hits;
+  atomic_uint_least64_t misses;
+  atomic_uint_least64_t evictions;
 };
-static pthread_key_t key;
-static pthread_once_t key_once = PTHREAD_ONCE_INIT;
+
+static re_cache* shared_cache_ptr;
+static pthread_once_t shared_cache_once = PTHREAD_ONCE_INIT;
 
 static
-void make_key(void)
+void make_shared_cache(void)
 {
-  (void) pthread_key_create(&key, NULL);
+  re_cache* c = new re_cache;
+  int64_t capacity = REGEXP_CACHE_DEFAULT_SIZE;
+#ifndef CHPL_RT_UNIT_TEST
+  const char* env = chpl_get_rt_env("REGEXP_CACHE_SIZE", NULL);
+  if( env ) {
+    int64_t val;
+    if( sscanf(env, "%" SCNi64, &val) == 1 && val >= 0 )
+      capacity = val;
+    else
+      chpl_warning("CHPL_RT_REGEXP_CACHE_SIZE must be a non-negative integer",
+                   0, 0);
+  }
+#endif
+  pthread_rwlock_init(&c->lock, NULL);
+  c->capacity = capacity;
+  c->hand = 0;
+  c->nentries = 0;
+  c->elems = (cache_elem*) qio_calloc(capacity ? capacity : 1,
+                                      sizeof(cache_elem));
+  atomic_init_uint_least64_t(&c->hits, 0);
+  atomic_init_uint_least64_t(&c->misses, 0);
+  atomic_init_uint_least64_t(&c->evictions, 0);
+  shared_cache_ptr = c;
 }
 
 static inline
-re_cache* local_cache(void)
+re_cache* shared_cache(void)
 {
-  re_cache* ptr;
-  (void) pthread_once(&key_once, make_key);
-  if((ptr = (re_cache*) pthread_getspecific(key)) == NULL) {
-    ptr = (re_cache*) qio_malloc(sizeof(re_cache));
-    memset(ptr, 0, sizeof(re_cache));
-    (void) pthread_setspecific(key, ptr);
-  }
-  return ptr;
+  (void) pthread_once(&shared_cache_once, make_shared_cache);
+  return shared_cache_ptr;
 }
 
 static
@@ -120,53 +156,148 @@ void re_free(re_t* re)
 
 
 static
-re_t* local_cache_get(const char* str, int64_t str_len, const qio_regexp_options_t* options) {
-  re_cache* c = local_cache();
-  int oldest;
-  int64_t oldest_date;
-  c->date++;
-  // Find either the oldest element
-  // or a matching element
-  oldest = 0;
-  oldest_date = c->elems[0].date;
-  for( int i = 0; i < REGEXP_CACHE_SIZE; i++ ) {
-    if( c->elems[i].date < oldest_date ) {
-      oldest = i;
-      oldest_date = c->elems[i].date;
-    }
-    if( ! c->elems[i].re ) continue;
-    const string& pat = c->elems[i].re->re.pattern();
-    const RE2::Options& opt = c->elems[i].re->re.options();
+uint64_t hash_pattern(const char* str, int64_t str_len,
+                      const qio_regexp_options_t* options)
+{
+  // FNV-1a over the options and then the pattern
+  const qio_bool flags[] = { options->utf8, options->posix, options->literal,
+                             options->nocapture, options->ignorecase,
+                             options->multiline, options->dotnl,
+                             options->nongreedy };
+  uint64_t h = 14695981039346656037ULL;
+  for( size_t i = 0; i < sizeof(flags)/sizeof(flags[0]); i++ ) {
+    h ^= (uint64_t) (flags[i] != 0);
+    h *= 1099511628211ULL;
+  }
+  for( int64_t i = 0; i < str_len; i++ ) {
+    h ^= (unsigned char) str[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+// Returns the cached regexp for a pattern, retained for the caller, or
+// NULL.  The cache lock must be held (for reading or writing).
+static
+re_t* shared_cache_find_locked(re_cache* c, uint64_t hash,
+                               const char* str, int64_t str_len,
+                               const qio_regexp_options_t* options)
+{
+  auto range = c->index.equal_range(hash);
+  for( auto it = range.first; it != range.second; ++it ) {
+    cache_elem* e = &c->elems[it->second];
+    const string& pat = e->re->re.pattern();
+    const RE2::Options& opt = e->re->re.options();
     if( (uint64_t) pat.length() == (uint64_t) str_len &&
         0 == memcmp(pat.data(), str, str_len ) &&
         equal_options(&opt, options) ) {
-      // Make the date current.
-      c->elems[i].date = c->date;
-      // Return this element.
-      re_t* re = c->elems[i].re;
+      e->used = 1;
       // We increment the reference count before returning a copy to the
       // caller.  It is up to the caller to release the re_t handle when done.
-      DO_RETAIN(re);
-      return re;
+      DO_RETAIN(e->re);
+      return e->re;
     }
   }
+  return NULL;
+}
 
-  // If we found no match, replace oldest.
-  if( c->elems[oldest].re) DO_RELEASE(c->elems[oldest].re, re_free);
+// Returns a free slot, evicting an entry if the cache is full.  The cache
+// lock must be held for writing.
+static
+cache_elem* shared_cache_victim_locked(re_cache* c)
+{
+  while( true ) {
+    cache_elem* e = &c->elems[c->hand];
+    c->hand = (c->hand + 1) % c->capacity;
+    if( ! e->re ) return e;
+    if( e->used ) {
+      e->used = 0;
+      continue;
+    }
 
-  // Put a new RE in that slot.
+    // Evict this entry.  Copies still held by callers remain valid.
+    auto range = c->index.equal_range(e->hash);
+    for( auto it = range.first; it != range.second; ++it ) {
+      if( &c->elems[it->second] == e ) {
+        c->index.erase(it);
+        break;
+      }
+    }
+    DO_RELEASE(e->re, re_free);
+    e->re = NULL;
+    c->nentries--;
+    atomic_fetch_add_uint_least64_t(&c->evictions, 1);
+    return e;
+  }
+}
+
+// The returned re_t has been retained for the caller.
+static
+re_t* shared_cache_get(const char* str, int64_t str_len, const qio_regexp_options_t* options) {
+  re_cache* c = shared_cache();
+  uint64_t hash = hash_pattern(str, str_len, options);
+  re_t* re;
+
+  pthread_rwlock_rdlock(&c->lock);
+  re = shared_cache_find_locked(c, hash, str, str_len, options);
+  pthread_rwlock_unlock(&c->lock);
+  if( re ) {
+    atomic_fetch_add_uint_least64_t(&c->hits, 1);
+    return re;
+  }
+  atomic_fetch_add_uint_least64_t(&c->misses, 1);
+
+  // Compile without holding the lock.  The cache's reference is the
+  // initial one.
   RE2::Options opts;
   qio_re_options_to_re2_options(options, &opts);
   StringPiece strp(str, str_len);
-  re_t* re = new re_t(strp, opts, c);
-  c->elems[oldest].date = c->date;
-  c->elems[oldest].re = re;
-  // We increment the reference count before returning a copy to the
-  // caller.  It is up to the caller to release the re_t handle when done.
-  DO_RETAIN(re);
+  re_t* fresh = new re_t(strp, opts);
+
+  if( c->capacity == 0 ) {
+    // Nothing to cache it in, so the caller gets the only reference.
+    return fresh;
+  }
+
+  pthread_rwlock_wrlock(&c->lock);
+  // Another thread may have added the same pattern in the meantime.
+  re = shared_cache_find_locked(c, hash, str, str_len, options);
+  if( ! re ) {
+    cache_elem* e = shared_cache_victim_locked(c);
+    e->re = fresh;
+    e->hash = hash;
+    e->used = 1;
+    c->index.insert(std::make_pair(hash, (int64_t) (e - c->elems)));
+    c->nentries++;
+    re = fresh;
+    fresh = NULL;
+    DO_RETAIN(re);
+  }
+  pthread_rwlock_unlock(&c->lock);
+
+  if( fresh ) re_free(fresh);
   return re;
 }
 
+void qio_regexp_get_cache_stats(qio_regexp_cache_stats_t* stats)
+{
+  re_cache* c = shared_cache();
+  stats->hits = atomic_load_uint_least64_t(&c->hits);
+  stats->misses = atomic_load_uint_least64_t(&c->misses);
+  stats->evictions = atomic_load_uint_least64_t(&c->evictions);
+  pthread_rwlock_rdlock(&c->lock);
+  stats->entries = c->nentries;
+  pthread_rwlock_unlock(&c->lock);
+  stats->capacity = c->capacity;
+}
+
+void qio_regexp_reset_cache_stats(void)
+{
+  re_cache* c = shared_cache();
+  atomic_store_uint_least64_t(&c->hits, 0);
+  atomic_store_uint_least64_t(&c->misses, 0);
+  atomic_store_uint_least64_t(&c->evictions, 0);
+}
 
 
 void qio_regexp_init_default_options(qio_regexp_options_t* opt)
@@ -184,12 +315,12 @@ void qio_regexp_init_default_options(qio_regexp_options_t* opt)
 // The returned re_t (passed back through "compiled") must be released by the caller.
 void qio_regexp_create_compile(const char* str, int64_t str_len, const qio_regexp_options_t* options, qio_regexp_t* compiled)
 {
-  re_t* regexp = local_cache_get(str, str_len, options);
+  // The cache has already bumped the reference count, because the caller
+  // "owns" its copy of the cached regexp.  This way, a regexp can be removed
+  // from the cache without causing a copy that is still in use to be
+  // deleted early.
+  re_t* regexp = shared_cache_get(str, str_len, options);
   compiled->regexp = (void*) regexp;
-  // We bump the reference count, because caller "owns" its copy of the cached
-  // regexp.  This way, a regexp can be removed from the cache without causing a
-  // copy that is still in use to be deleted early.
-  DO_RETAIN(regexp);
 }
 
 // The re_t returned in compiled must be released by the caller.
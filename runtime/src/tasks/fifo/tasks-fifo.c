@@ -25,6 +25,7 @@
 #include "chpl_rt_utils_static.h"
 #include "chplcgfns.h"
 #include "chpl-comm.h"
+#include "chpl-env.h"
 #include "chplexit.h"
 #include "chpl-locale-model.h"
 #include "chpl-mem.h"
@@ -50,11 +51,29 @@
 //
 typedef struct task_pool_struct* task_pool_p;
 
+//
+// In work-stealing mode each thread also has its own pool of tasks, a
+// deque.  Tasks a thread creates go on its deque.  The thread takes
+// tasks from the tail of its own deque (newest first), and idle threads
+// steal from the head (oldest first).  A deque's lock protects the
+// deque.  Task lists have their own locks, because tasks created by
+// begin statements in different threads can be put on the same list
+// (that of the enclosing sync statement, say) and so a list can span
+// deques.  When both are needed the deque lock is taken first.
+//
+typedef struct {
+  chpl_thread_mutex_t   lock;
+  volatile task_pool_p  head;
+  volatile task_pool_p  tail;
+  uint32_t              steal_seed;  // used only by the owning thread
+} task_deque_t;
+
 typedef struct {
   chpl_task_prvData_t prvdata;
 } chpl_task_prvDataImpl_t;
 
 typedef struct task_pool_struct {
+  task_deque_t*    deque;        // deque we're on, or NULL for the pool
   task_pool_p*     p_list_head;  // task list we're on, if any
   task_pool_p      list_next;    // double-link pointers for list
   task_pool_p      list_prev;
@@ -79,6 +98,7 @@ typedef struct lockReport {
 // This is the data that is private to each thread.
 typedef struct {
   task_pool_p   ptask;
+  task_deque_t* deque;
   lockReport_t* lockRprt;
 } thread_private_data_t;
 
@@ -116,11 +136,34 @@ static chpl_thread_mutex_t taskTable_lock;     // critical section lock
 
 static chpl_fn_p comm_task_fn;
 
+static chpl_bool           work_stealing = false;
+static task_deque_t**      task_deques;        // all threads' deques
+static volatile int        num_task_deques;
+static int                 max_task_deques;
+
+#define NUM_TASK_LIST_LOCKS 64
+static chpl_thread_mutex_t task_list_locks[NUM_TASK_LIST_LOCKS];
+
+//
+// Is there possibly a task for an idle thread to run?
+//
+#define TASKS_QUEUED() \
+  (work_stealing ? *(volatile int*) &queued_task_cnt > 0 \
+                 : task_pool_head != NULL)
+
 //
 // Internal functions.
 //
 static void                    enqueue_task(task_pool_p, task_pool_p*);
 static void                    dequeue_task(task_pool_p);
+static void                    lock_pool(task_deque_t*);
+static void                    unlock_pool(task_deque_t*);
+static task_deque_t*           new_task_deque(void);
+static void                    lock_task_list(task_pool_p*);
+static void                    unlock_task_list(task_pool_p*);
+static task_pool_p             take_from_task_list(task_pool_p*);
+static task_pool_p             find_task(task_deque_t*);
+static void                    update_task_cnt(int*, int);
 static void                    comm_task_wrapper(void*);
 static void                    taskCallBody(chpl_fn_int_t, chpl_fn_p,
                                             chpl_task_bundle_t*, size_t,
@@ -143,6 +186,7 @@ static void                    maybe_add_thread(void);
 static task_pool_p             add_to_task_pool(chpl_fn_int_t, chpl_fn_p,
                                                 chpl_task_bundle_t*, size_t,
                                                 chpl_bool, chpl_bool, chpl_bool,
+                                                task_deque_t*,
                                                 task_pool_p*, chpl_bool,
                                                 int, int32_t);
 
@@ -317,8 +361,10 @@ static void setup_main_thread_private_data(void)
   tp->ptask = (task_pool_p) chpl_mem_alloc(sizeof(task_pool_t),
                                            CHPL_RT_MD_TASK_POOL_DESC,
                                            0, 0);
+  tp->deque               = NULL;
   tp->lockRprt            = NULL;
 
+  tp->ptask->deque        = NULL;
   tp->ptask->p_list_head  = NULL;
   tp->ptask->list_next    = NULL;
   tp->ptask->list_prev    = NULL;
@@ -344,6 +390,8 @@ static void setup_main_thread_private_data(void)
 // Tasks
 
 void chpl_task_init(void) {
+  int i;
+
   chpl_thread_mutexInit(&threading_lock);
   chpl_thread_mutexInit(&extra_task_lock);
   chpl_thread_mutexInit(&task_id_lock);
@@ -355,6 +403,20 @@ void chpl_task_init(void) {
   extra_task_cnt = 0;
   task_pool_head = task_pool_tail = NULL;
 
+  work_stealing = chpl_get_rt_env_bool("WORK_STEALING", false);
+  if (work_stealing) {
+    max_task_deques = (int) chpl_thread_getMaxThreads();
+    if (max_task_deques <= 0)
+      max_task_deques = 1024;
+    task_deques = (task_deque_t**) chpl_mem_allocMany(max_task_deques,
+                                                      sizeof(task_deque_t*),
+                                                      CHPL_RT_MD_THREAD_PRV_DATA,
+                                                      0, 0);
+    num_task_deques = 0;
+    for (i = 0; i < NUM_TASK_LIST_LOCKS; i++)
+      chpl_thread_mutexInit(&task_list_locks[i]);
+  }
+
   chpl_thread_init(thread_begin, thread_end);
 
   //
@@ -396,6 +458,7 @@ static void* do_callMain(void* arg) {
 
   // make sure this thread has thread-private data.
   setup_main_thread_private_data();
+  get_thread_private_data()->deque = new_task_deque();
 
   // make sure that the lock report is set up.
   if (blockreport)
@@ -523,8 +586,10 @@ static void comm_task_wrapper(void* arg) {
   tp->ptask = (task_pool_p) chpl_mem_alloc(sizeof(task_pool_t),
                                            CHPL_RT_MD_TASK_POOL_DESC,
                                            0, 0);
+  tp->deque               = NULL;
   tp->lockRprt            = NULL;
 
+  tp->ptask->deque        = NULL;
   tp->ptask->p_list_head  = NULL;
   tp->ptask->list_next    = NULL;
   tp->ptask->list_prev    = NULL;
@@ -550,19 +615,33 @@ static void comm_task_wrapper(void* arg) {
 //
 // Enqueue and dequeue tasks from the pool.
 //
+// The caller must hold the lock for the task's deque (see lock_pool()).
+//
 static inline
 void enqueue_task(task_pool_p ptask, task_pool_p* p_task_list_head) {
-  queued_task_cnt++;
+  volatile task_pool_p* p_head;
+  volatile task_pool_p* p_tail;
+
+  update_task_cnt(&queued_task_cnt, 1);
 
   //
-  // Add to pool.
+  // Add to pool or deque.
   //
-  if (task_pool_tail)
-    task_pool_tail->next = ptask;
+  if (ptask->deque == NULL) {
+    p_head = &task_pool_head;
+    p_tail = &task_pool_tail;
+  }
+  else {
+    p_head = &ptask->deque->head;
+    p_tail = &ptask->deque->tail;
+  }
+
+  if (*p_tail)
+    (*p_tail)->next = ptask;
   else
-    task_pool_head = ptask;
-  ptask->prev = task_pool_tail;
-  task_pool_tail = ptask;
+    *p_head = ptask;
+  ptask->prev = *p_tail;
+  *p_tail = ptask;
 
   //
   // Add to list, if any.
@@ -571,33 +650,47 @@ void enqueue_task(task_pool_p ptask, task_pool_p* p_task_list_head) {
     ptask->p_list_head = NULL;
   }
   else {
+    lock_task_list(p_task_list_head);
     ptask->p_list_head = p_task_list_head;
     ptask->list_next = *p_task_list_head;
     if (*p_task_list_head != NULL)
       (*p_task_list_head)->list_prev = ptask;
     ptask->list_prev = NULL;
     *p_task_list_head = ptask;
+    unlock_task_list(p_task_list_head);
   }
 }
 
 
 static inline
 void dequeue_task(task_pool_p ptask) {
+  volatile task_pool_p* p_head;
+  volatile task_pool_p* p_tail;
+
   assert(queued_task_cnt > 0);
-  queued_task_cnt--;
+  update_task_cnt(&queued_task_cnt, -1);
 
   //
-  // Remove from pool.
+  // Remove from pool or deque.
   //
-  if (ptask == task_pool_head) {
-    if ((task_pool_head = task_pool_head->next) == NULL)
-      task_pool_tail = NULL;
+  if (ptask->deque == NULL) {
+    p_head = &task_pool_head;
+    p_tail = &task_pool_tail;
+  }
+  else {
+    p_head = &ptask->deque->head;
+    p_tail = &ptask->deque->tail;
+  }
+
+  if (ptask == *p_head) {
+    if ((*p_head = (*p_head)->next) == NULL)
+      *p_tail = NULL;
     else
-      task_pool_head->prev = NULL;
+      (*p_head)->prev = NULL;
   }
   else {
     if ((ptask->prev->next = ptask->next) == NULL)
-      task_pool_tail = ptask->prev;
+      *p_tail = ptask->prev;
     else
       ptask->next->prev = ptask->prev;
   }
@@ -606,13 +699,200 @@ void dequeue_task(task_pool_p ptask) {
   // Remove from list, if on one.
   //
   if (ptask->p_list_head != NULL) {
+    lock_task_list(ptask->p_list_head);
     if (ptask == *(ptask->p_list_head))
       *(ptask->p_list_head) = ptask->list_next;
     else
       ptask->list_prev->list_next = ptask->list_next;
     if (ptask->list_next != NULL)
       ptask->list_next->list_prev = ptask->list_prev;
+    unlock_task_list(ptask->p_list_head);
+  }
+}
+
+
+//
+// Lock and unlock a deque, or the shared pool if the deque is NULL.
+//
+static inline
+void lock_pool(task_deque_t* deque) {
+  chpl_thread_mutexLock(deque == NULL ? &threading_lock : &deque->lock);
+}
+
+
+static inline
+void unlock_pool(task_deque_t* deque) {
+  chpl_thread_mutexUnlock(deque == NULL ? &threading_lock : &deque->lock);
+}
+
+
+//
+// Lock and unlock a task list.  This is only needed in work-stealing
+// mode; otherwise the lists are protected by threading_lock along with
+// the pool.
+//
+static inline
+chpl_thread_mutex_t* task_list_lock_for(task_pool_p* p_task_list_head) {
+  uintptr_t h = (uintptr_t) p_task_list_head;
+  return &task_list_locks[(h >> 4) % NUM_TASK_LIST_LOCKS];
+}
+
+
+static inline
+void lock_task_list(task_pool_p* p_task_list_head) {
+  if (work_stealing)
+    chpl_thread_mutexLock(task_list_lock_for(p_task_list_head));
+}
+
+
+static inline
+void unlock_task_list(task_pool_p* p_task_list_head) {
+  if (work_stealing)
+    chpl_thread_mutexUnlock(task_list_lock_for(p_task_list_head));
+}
+
+
+//
+// Remove the first task from a task list, and from its pool or deque,
+// in work-stealing mode.  We have to lock the deque before the list,
+// but we can only find out which deque to lock by looking at the list.
+// So we look, lock that deque, and then check that the first task on
+// the list is still one in that deque, starting over if not.
+//
+static task_pool_p take_from_task_list(task_pool_p* p_task_list_head) {
+  while (true) {
+    task_pool_p ptask;
+    task_deque_t* deque;
+
+    lock_task_list(p_task_list_head);
+    if ((ptask = *p_task_list_head) != NULL)
+      deque = ptask->deque;
+    unlock_task_list(p_task_list_head);
+
+    if (ptask == NULL)
+      return NULL;
+
+    lock_pool(deque);
+    lock_task_list(p_task_list_head);
+    if ((ptask = *p_task_list_head) != NULL && ptask->deque != deque)
+      ptask = NULL;
+    unlock_task_list(p_task_list_head);
+
+    // Only our deque lock is needed to keep ptask where it is now.
+    if (ptask != NULL)
+      dequeue_task(ptask);
+    unlock_pool(deque);
+
+    if (ptask != NULL)
+      return ptask;
+  }
+}
+
+
+//
+// In work-stealing mode the task counters are not protected by
+// threading_lock, so they have to be updated atomically.
+//
+static inline
+void update_task_cnt(int* cnt, int delta) {
+  if (work_stealing)
+    (void) __sync_fetch_and_add(cnt, delta);
+  else
+    *cnt += delta;
+}
+
+
+//
+// Create a deque for the calling thread, if we're work stealing and
+// there's room for another one.  Threads without deques use the shared
+// pool.
+//
+static task_deque_t* new_task_deque(void) {
+  task_deque_t* deque;
+
+  if (!work_stealing)
+    return NULL;
+
+  // begin critical section
+  chpl_thread_mutexLock(&threading_lock);
+
+  if (num_task_deques >= max_task_deques) {
+    chpl_thread_mutexUnlock(&threading_lock);
+    return NULL;
   }
+
+  deque = (task_deque_t*) chpl_mem_alloc(sizeof(task_deque_t),
+                                         CHPL_RT_MD_THREAD_PRV_DATA, 0, 0);
+  chpl_thread_mutexInit(&deque->lock);
+  deque->head = deque->tail = NULL;
+  deque->steal_seed = (uint32_t) num_task_deques + 1;
+
+  // Publish the deque before making it visible to thieves.
+  task_deques[num_task_deques] = deque;
+  __sync_synchronize();
+  num_task_deques++;
+
+  // end critical section
+  chpl_thread_mutexUnlock(&threading_lock);
+
+  return deque;
+}
+
+
+//
+// Find a task for an idle thread to run, in work-stealing mode.  Look
+// first at the newest task in the thread's own deque, then at the
+// oldest one in the shared pool, and finally try to steal the oldest
+// task from another thread's deque, starting with a random victim.
+// The task is removed from its deque or pool before it is returned.
+//
+static task_pool_p find_task(task_deque_t* my_deque) {
+  task_pool_p ptask;
+  int n, start, i;
+
+  if (my_deque != NULL && my_deque->tail != NULL) {
+    lock_pool(my_deque);
+    if ((ptask = my_deque->tail) != NULL)
+      dequeue_task(ptask);
+    unlock_pool(my_deque);
+    if (ptask != NULL)
+      return ptask;
+  }
+
+  if (task_pool_head != NULL) {
+    lock_pool(NULL);
+    if ((ptask = task_pool_head) != NULL)
+      dequeue_task(ptask);
+    unlock_pool(NULL);
+    if (ptask != NULL)
+      return ptask;
+  }
+
+  if ((n = num_task_deques) == 0)
+    return NULL;
+
+  if (my_deque != NULL) {
+    my_deque->steal_seed = my_deque->steal_seed * 1103515245 + 12345;
+    start = (int) ((my_deque->steal_seed >> 16) % n);
+  }
+  else
+    start = 0;
+
+  for (i = 0; i < n; i++) {
+    task_deque_t* victim = task_deques[(start + i) % n];
+
+    if (victim == my_deque || victim->head == NULL)
+      continue;
+
+    lock_pool(victim);
+    if ((ptask = victim->head) != NULL)
+      dequeue_task(ptask);
+    unlock_pool(victim);
+    if (ptask != NULL)
+      return ptask;
+  }
+
+  return NULL;
 }
 
 
@@ -625,6 +905,7 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
                              int lineno,
                              int32_t filename) {
   task_pool_p curr_ptask = get_current_ptask();
+  task_deque_t* deque = get_thread_private_data()->deque;
   bool serial_state = curr_ptask->bundle.serial_state;
 
   assert(subloc == 0 || subloc == c_sublocid_any);
@@ -635,11 +916,11 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
   }
 
   // begin critical section
-  chpl_thread_mutexLock(&threading_lock);
+  lock_pool(deque);
 
   if (task_list_locale == chpl_nodeID) {
     (void) add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
-                            false, false, false,
+                            false, false, false, deque,
                             (task_pool_p*) p_task_list_void, is_begin_stmt,
                             lineno, filename);
 
@@ -652,12 +933,12 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
     //
     assert(is_begin_stmt);
     (void) add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
-                            false, false, false,
+                            false, false, false, deque,
                             NULL, true, 0, CHPL_FILE_IDX_UNKNOWN);
   }
 
   // end critical section
-  chpl_thread_mutexUnlock(&threading_lock);
+  unlock_pool(deque);
 }
 
 
@@ -677,16 +958,22 @@ void chpl_task_executeTasksInList(void** p_task_list_void) {
   while (*p_task_list_head != NULL) {
     chpl_fn_p task_to_run_fun = NULL;
 
-    // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
-
-    if ((child_ptask = *p_task_list_head) != NULL) {
-      task_to_run_fun = child_ptask->bundle.requested_fn;
-      dequeue_task(child_ptask);
+    if (work_stealing) {
+      if ((child_ptask = take_from_task_list(p_task_list_head)) != NULL)
+        task_to_run_fun = child_ptask->bundle.requested_fn;
     }
+    else {
+      // begin critical section
+      chpl_thread_mutexLock(&threading_lock);
 
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+      if ((child_ptask = *p_task_list_head) != NULL) {
+        task_to_run_fun = child_ptask->bundle.requested_fn;
+        dequeue_task(child_ptask);
+      }
+
+      // end critical section
+      chpl_thread_mutexUnlock(&threading_lock);
+    }
 
     if (task_to_run_fun == NULL)
       continue;
@@ -772,7 +1059,7 @@ void taskCallBody(chpl_fn_int_t fid, chpl_fn_p fp,
   chpl_thread_mutexLock(&threading_lock);
 
   (void) add_to_task_pool(fid, fp, arg, arg_size,
-                          serial_state, canCountRunningTasks, true,
+                          serial_state, canCountRunningTasks, true, NULL,
                           NULL, false, lineno, filename);
 
   // end critical section
@@ -996,6 +1283,7 @@ static void report_locked_threads(void) {
 //
 static void report_all_tasks(void) {
   task_pool_p pendingTask = task_pool_head;
+  int i;
 
   printf("Task report\n");
   printf("--------------------------------\n");
@@ -1007,6 +1295,14 @@ static void report_all_tasks(void) {
            pendingTask->bundle.lineno);
     pendingTask = pendingTask->next;
   }
+  for (i = 0; i < num_task_deques; i++) {
+    for (pendingTask = task_deques[i]->head;
+         pendingTask != NULL;
+         pendingTask = pendingTask->next) {
+      printf("- %s:%d\n", chpl_lookupFilename(pendingTask->bundle.filename),
+             pendingTask->bundle.lineno);
+    }
+  }
   printf("\n");
 
   // print out running tasks
@@ -1166,6 +1462,7 @@ thread_begin(void* ptask_void) {
                                                0, 0);
   chpl_thread_setPrivateData(tp);
 
+  tp->deque = new_task_deque();
   tp->lockRprt = NULL;
   if (blockreport)
     initializeLockReportForThread();
@@ -1185,7 +1482,7 @@ thread_begin(void* ptask_void) {
     // that were waiting on the signal, but since there was a performance
     // impact from keeping it as a hybrid as opposed to merely yielding,
     // it was decided that we would return to the simple yield case.
-    while (!task_pool_head) {
+    while (!TASKS_QUEUED()) {
       if (set_block_loc(0, CHPL_FILE_IDX_IDLE_TASK)) {
         // all other tasks appear to be blocked
         struct timeval deadline, now;
@@ -1193,56 +1490,72 @@ thread_begin(void* ptask_void) {
         deadline.tv_sec += 1;
         do {
           chpl_thread_yield();
-          if (!task_pool_head)
+          if (!TASKS_QUEUED())
             gettimeofday(&now, NULL);
-        } while (!task_pool_head
+        } while (!TASKS_QUEUED()
                  && (now.tv_sec < deadline.tv_sec
                      || (now.tv_sec == deadline.tv_sec
                          && now.tv_usec < deadline.tv_usec)));
-        if (!task_pool_head) {
+        if (!TASKS_QUEUED()) {
           check_for_deadlock();
         }
       }
       else {
         do {
           chpl_thread_yield();
-        } while (!task_pool_head);
+        } while (!TASKS_QUEUED());
       }
 
       unset_block_loc();
     }
- 
-    //
-    // Just now the pool had at least one task in it.  Lock and see if
-    // there's something still there.
-    //
-    chpl_thread_mutexLock(&threading_lock);
-    if (!task_pool_head) {
-      chpl_thread_mutexUnlock(&threading_lock);
-      continue;
+
+    if (work_stealing) {
+      //
+      // Just now some pool or deque had at least one task in it.  See
+      // if we can get one.
+      //
+      if ((ptask = find_task(tp->deque)) == NULL)
+        continue;
+
+      if (blockreport)
+        progress_cnt++;
+
+      update_task_cnt(&idle_thread_cnt, -1);
+      update_task_cnt(&running_task_cnt, 1);
     }
+    else {
+      //
+      // Just now the pool had at least one task in it.  Lock and see if
+      // there's something still there.
+      //
+      chpl_thread_mutexLock(&threading_lock);
+      if (!task_pool_head) {
+        chpl_thread_mutexUnlock(&threading_lock);
+        continue;
+      }
 
-    //
-    // We've found a task to run.
-    //
+      //
+      // We've found a task to run.
+      //
 
-    if (blockreport)
-      progress_cnt++;
+      if (blockreport)
+        progress_cnt++;
 
-    //
-    // start new task; increment running count and remove task from pool
-    // also add to task to task-table (structure in ChapelRuntime that keeps
-    // track of currently running tasks for task-reports on deadlock or
-    // Ctrl+C).
-    //
-    ptask = task_pool_head;
-    idle_thread_cnt--;
-    running_task_cnt++;
+      //
+      // start new task; increment running count and remove task from pool
+      // also add to task to task-table (structure in ChapelRuntime that keeps
+      // track of currently running tasks for task-reports on deadlock or
+      // Ctrl+C).
+      //
+      ptask = task_pool_head;
+      idle_thread_cnt--;
+      running_task_cnt++;
 
-    dequeue_task(ptask);
+      dequeue_task(ptask);
 
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+      // end critical section
+      chpl_thread_mutexUnlock(&threading_lock);
+    }
 
     tp->ptask = ptask;
 
@@ -1283,18 +1596,24 @@ thread_begin(void* ptask_void) {
     tp->ptask = NULL;
     chpl_mem_free(ptask, 0, 0);
 
-    // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
-
     //
     // finished task; decrement running count and increment idle count
     //
-    assert(running_task_cnt > 0);
-    running_task_cnt--;
-    idle_thread_cnt++;
+    if (work_stealing) {
+      update_task_cnt(&running_task_cnt, -1);
+      update_task_cnt(&idle_thread_cnt, 1);
+    }
+    else {
+      // begin critical section
+      chpl_thread_mutexLock(&threading_lock);
 
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+      assert(running_task_cnt > 0);
+      running_task_cnt--;
+      idle_thread_cnt++;
+
+      // end critical section
+      chpl_thread_mutexUnlock(&threading_lock);
+    }
   }
 }
 
@@ -1326,7 +1645,7 @@ static void maybe_add_thread(void) {
 
   if (!warning_issued && chpl_thread_canCreate()) {
     if (chpl_thread_create(NULL) == 0) {
-      idle_thread_cnt++;
+      update_task_cnt(&idle_thread_cnt, 1);
     }
     else {
       int32_t max_threads = chpl_thread_getMaxThreads();
@@ -1350,14 +1669,15 @@ static void maybe_add_thread(void) {
 
 
 // create a task from the given function pointer and arguments
-// and append it to the end of the task pool
-// assumes threading_lock has already been acquired!
+// and append it to the end of the task pool, or of the given deque
+// assumes the lock for the pool or deque has already been acquired!
 static inline
 task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
                              chpl_task_bundle_t* a, size_t a_size,
                              chpl_bool serial_state,
                              chpl_bool countRunningTasks,
                              chpl_bool is_executeOn,
+                             task_deque_t* deque,
                              task_pool_p* p_task_list_head,
                              chpl_bool is_begin_stmt,
                              int lineno, int32_t filename) {
@@ -1378,6 +1698,7 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
 
   memcpy(&ptask->bundle, a, a_size);
 
+  ptask->deque                  = deque;
   ptask->p_list_head            = NULL;
   ptask->list_next              = NULL;
   ptask->list_prev              = NULL;
@@ -1419,7 +1740,13 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
   //
   if (queued_task_cnt > idle_thread_cnt &&
       (p_task_list_head == NULL || ptask->list_next != NULL || is_begin_stmt)) {
-    maybe_add_thread();
+    if (deque == NULL)
+      maybe_add_thread();
+    else if (chpl_thread_canCreate()) {
+      chpl_thread_mutexLock(&threading_lock);
+      maybe_add_thread();
+      chpl_thread_mutexUnlock(&threading_lock);
+    }
   }
 
   return ptask;
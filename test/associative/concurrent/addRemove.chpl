@@ -0,0 +1,42 @@
+//
+// Concurrent adds, removes and implicit array adds on parSafe
+// associative domains, including tasks racing to add the same index.
+//
+config const n = 20000;
+config const numTasks = 8;
+
+var D: domain(int);
+var A: [D] int;
+
+coforall t in 0..#numTasks do
+  for i in 0..#n do
+    D += i;
+writeln(D.size == n);
+
+forall i in D do A[i] = i;
+writeln(+ reduce A == n*(n-1)/2);
+
+coforall t in 0..#numTasks do
+  for i in t..n-1 by numTasks do
+    D -= i;
+writeln(D.size);
+
+coforall t in 0..#numTasks do
+  for i in 0..#n by 2 do
+    D += i;
+writeln(D.size, " ", + reduce [i in D] (i%2));
+
+var S: domain(string);
+coforall t in 0..#numTasks do
+  for i in 0..#1000 do
+    S += i:string;
+writeln(S.size);
+
+var B: [S] int;
+coforall t in 0..#numTasks do
+  for i in t..999 by numTasks do
+    B[i:string] = i;
+writeln(+ reduce B == 999*1000/2);
+
+D.clear();
+writeln(D.size);
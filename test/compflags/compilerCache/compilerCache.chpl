@@ -0,0 +1,4 @@
+// The second compilation should reuse the printchplenv output saved by
+// the first, and both executables should behave identically.
+config const n = 10;
+writeln(+ reduce [i in 1..n] i*i);
@@ -0,0 +1,6 @@
+// The second compilation should reuse the objects cached by the first,
+// and the two executables should behave identically.
+var A: [1..10] int;
+forall i in 1..10 do A[i] = i*i;
+writeln(+ reduce A);
+writeln("Computing...");
@@ -0,0 +1,52 @@
+use StencilDist;
+
+config const n = 10;
+
+inline proc wrap(i) return mod(i - 1, n) + 1;
+
+inline proc value(i, j, gen) return gen*n*n + wrap(i)*n + wrap(j);
+
+//
+// Update the fluff with beginUpdateFluff()/waitFluff() after a first
+// blocking update, and check each locale's cached copy.  When corners
+// are skipped they should still hold the first update's values.
+//
+proc test(periodic : bool, corners : bool) {
+  const Dom = {1..n, 1..n};
+  const Space = Dom dmapped Stencil(Dom, fluff=(1,1), periodic=periodic);
+  var A : [Space] int;
+
+  forall (i,j) in Space do A[i,j] = value(i, j, 1);
+  A.updateFluff();
+  forall (i,j) in Space do A[i,j] = value(i, j, 2);
+
+  const h = A.beginUpdateFluff(corners=corners);
+  A.waitFluff(h);
+
+  var errors : atomic int;
+  coforall loc in Locales do on loc {
+    const myBlock = Space.localSubdomain();
+    if myBlock.size > 0 {
+      for (i,j) in myBlock.expand(1) {
+        if myBlock.member(i,j) then continue;
+        if !periodic && !Dom.member(i,j) then continue;
+        const corner = !myBlock.dim(1).member(i) && !myBlock.dim(2).member(j);
+        const gen = if corner && !corners then 1 else 2;
+        if A[i,j] != value(i, j, gen) {
+          writeln("periodic=", periodic, " corners=", corners, ": ",
+                  (i,j), " on ", here.id, " is ", A[i,j],
+                  ", expected ", value(i, j, gen));
+          errors.add(1);
+        }
+      }
+    }
+  }
+  return errors.read();
+}
+
+var errors = 0;
+for periodic in (false, true) do
+  for corners in (false, true) do
+    errors += test(periodic, corners);
+
+if errors == 0 then writeln("Success!");
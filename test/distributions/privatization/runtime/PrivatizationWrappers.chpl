@@ -17,3 +17,13 @@ proc clearPrivatized(pid:int) {
   extern proc chpl_clearPrivatizedClass(pid:int);
   chpl_clearPrivatizedClass(pid);
 }
+
+proc reservePid(): int {
+  extern proc chpl_reservePrivatizedPid(): int;
+  return chpl_reservePrivatizedPid();
+}
+
+proc releasePid(pid:int) {
+  extern proc chpl_releasePrivatizedPid(pid:int);
+  chpl_releasePrivatizedPid(pid);
+}
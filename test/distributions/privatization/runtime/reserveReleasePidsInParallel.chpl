@@ -0,0 +1,40 @@
+use PrivatizationWrappers;
+
+config const numPids = 10000;
+
+// reserve a batch of pids in parallel, they must all be distinct
+var pids: [1..numPids] int;
+forall p in pids do
+  p = reservePid();
+
+var seen: [0..#numPids] atomic int;
+for p in pids do
+  seen[p].add(1);
+writeln(&& reduce [s in seen] s.read() == 1);
+
+// release them in parallel, reserving again must reuse the same pids
+forall p in pids do
+  releasePid(p);
+
+forall p in pids do
+  p = reservePid();
+
+for s in seen do
+  s.write(0);
+for p in pids do
+  seen[p].add(1);
+writeln(&& reduce [s in seen] s.read() == 1);
+
+// with everything reserved, the next pid is a new one
+writeln(reservePid() == numPids);
+
+// released pids can hold objects again
+forall p in pids {
+  releasePid(p);
+  const q = reservePid();
+  insertPrivatized(new C(q), q);
+  assert(getPrivatized(q).i == q);
+  delete getPrivatized(q);
+  clearPrivatized(q);
+}
+writeln("OK");
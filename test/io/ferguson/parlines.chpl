@@ -0,0 +1,48 @@
+use Sort, FileSystem;
+
+config const n = 10000;
+config const path = "parlines.txt";
+
+// Write lines of varying length, including some empty ones.
+{
+  var f = open(path, iomode.cw);
+  var w = f.writer();
+  for i in 1..n {
+    w.writeln(" " * (i % 17), i);
+    if i % 100 == 0 then w.writeln();
+  }
+  w.close();
+  f.close();
+}
+
+var f = open(path, iomode.r);
+
+// Every line should be read exactly once, in serial or in parallel.
+const nlines = n + n / 100;
+var serLines: [1..nlines] string;
+for (line, i) in zip(f.lines(), 1..) do
+  serLines[i] = line;
+
+var count: atomic int;
+var parLines: [1..nlines] string;
+forall line in f.lines() {
+  const i = count.fetchAdd(1) + 1;
+  parLines[i] = line;
+}
+writeln("lines: ", count.read());
+sort(serLines);
+sort(parLines);
+writeln("lines match: ", && reduce (serLines == parLines));
+
+// Reading items other than strings, starting part way into the file.
+var r = f.reader();
+var skip: string;
+r.readline(skip);
+var sum: atomic int;
+forall i in r.itemReader(int) do
+  sum.add(i);
+writeln("sum: ", sum.read() == (n * (n + 1)) / 2 - 1);
+writeln("reader at end: ", r.offset() == f.length());
+
+f.close();
+remove(path);
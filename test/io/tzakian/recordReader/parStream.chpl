@@ -0,0 +1,45 @@
+use RecordParser;
+
+// Records read in parallel should be the same ones read serially.
+
+record Beer {
+  var name:  string;
+  var beerId: int;
+  var brewerId: int;
+  var ABV: real;
+  var style: string;
+  var appearance: real;
+  var aroma: real;
+  var palate: real;
+  var taste: real;
+  var overall: real;
+  var time:  int;
+  var profileName:  string;
+  var text: string;
+}
+
+var strt = "\\s*beer/name: (.*)\\s*beer/beerId: (.*)\\s*beer/brewerId: (.*)\\s*beer/ABV: (.*)\\s*beer/style: (.*)\\s*review/appearance: (.*)\\s*review/aroma: (.*)\\s*review/palate: (.*)\\s*review/taste: (.*)\\s*review/overall: (.*)\\s*review/time: (.*)\\s*review/profileName: (.*)\\s*review/text: (.*)";
+
+var f = open("input2_beer.txt", iomode.r);
+
+var serialCount = 0, serialSum = 0;
+{
+  var N = new RecordReader(Beer, f.reader(), strt);
+  for r in N.stream() {
+    serialCount += 1;
+    serialSum += r.beerId * r.time;
+  }
+  delete N;
+}
+
+var N = new RecordReader(Beer, f.reader(), strt);
+var count, sum: int;
+forall r in N.stream() with (+ reduce count, + reduce sum) {
+  count += 1;
+  sum += r.beerId * r.time;
+}
+delete N;
+
+writeln("records: ", count);
+writeln("counts match: ", count == serialCount);
+writeln("sums match: ", sum == serialSum);
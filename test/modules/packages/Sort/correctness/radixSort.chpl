@@ -0,0 +1,54 @@
+/*
+ *  Check correctness of radixSort() on the key types it supports.
+ */
+
+use Sort;
+use Random;
+
+config const n = 10000;
+
+proc main() {
+  var R: [1..n] real;
+  fillRandom(R, seed=42);
+
+  testSort('int', [r in R] ((r - 0.5) * max(int)): int);
+  testSort('int(8)', [r in R] ((r - 0.5) * 255): int(8));
+  testSort('uint(16)', [r in R] (r * max(uint(16))): uint(16));
+  testSort('uint', [r in R] (r * max(uint)): uint);
+  testSort('real', [r in R] (r - 0.5) * 1.0e10);
+  testSort('real(32)', [r in R] (r - 0.5): real(32));
+
+  // Strided arrays
+  var S: [0..#2*n by 2] int = [r in R] (r * 1000): int;
+  radixSort(S);
+  writeln('strided: ', isSorted(S));
+
+  // Keys are compared via comparator.key, equal keys keep their order
+  var K: [1..n] (int, int) = [(r, i) in zip(R, 1..n)] ((r * 100): int, i);
+  radixSort(K, comparator=new FirstKey());
+  var stable = true;
+  for i in 2..n do
+    if K[i-1](1) == K[i](1) && K[i-1](2) > K[i](2) then
+      stable = false;
+  writeln('key: ', isSorted(K, comparator=new FirstKey()), ' stable: ', stable);
+
+  // Corner cases
+  var Empty: [1..0] int;
+  radixSort(Empty);
+  var One = [7];
+  radixSort(One);
+  var Same: [1..100] int = 3;
+  radixSort(Same);
+  writeln('corner cases: ', One[1], ' ', isSorted(Same));
+}
+
+proc testSort(name, in A) {
+  var Copy = A;
+  radixSort(A);
+  quickSort(Copy);
+  writeln(name, ': ', && reduce (A == Copy));
+}
+
+record FirstKey {
+  proc key(a) { return a(1); }
+}
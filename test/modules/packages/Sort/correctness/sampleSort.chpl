@@ -0,0 +1,44 @@
+/*
+ *  Check correctness of sampleSort() and sort() on distributed arrays.
+ */
+
+use Sort;
+use Random;
+use BlockDist, CyclicDist;
+
+config const n = 10000;
+
+proc main() {
+  const D = {1..n};
+  var R: [D] real;
+  fillRandom(R, seed=42);
+
+  const BD = D dmapped Block(D);
+  var B: [BD] int = [r in R] ((r - 0.5) * 1000): int;
+  testSort('Block', B);
+
+  const CD = D dmapped Cyclic(startIdx=1);
+  var C: [CD] real = R;
+  testSort('Cyclic', C);
+
+  // Non-numeric keys fall back to quickSort on each locale
+  var S: [BD] string = [r in R] ((r * 1000): int): string;
+  testSort('Block string', S);
+
+  var Rev: [BD] int = [r in R] (r * 1000): int;
+  sort(Rev, comparator=reverseComparator);
+  writeln('Block reverse: ', isSorted(Rev, comparator=reverseComparator));
+
+  // More locales than elements
+  const SD = {1..2} dmapped Block({1..2});
+  var Small: [SD] int = [2, 1];
+  sort(Small);
+  writeln('Block small: ', Small);
+}
+
+proc testSort(name, A) {
+  var Copy: [1..n] A.eltType = A;
+  sampleSort(A);
+  quickSort(Copy);
+  writeln(name, ': ', isSorted(A) && && reduce (A == Copy));
+}
@@ -0,0 +1,49 @@
+/*
+    Performance test of the parallel sorts on n random int(64) keys: radixSort
+    on a local array and sampleSort (via sort()) on a Block-distributed array.
+ */
+
+use Sort;
+use Random;
+use Time;
+use BlockDist;
+
+config const n = 1000000,
+             printTiming = false;
+
+proc main() {
+  const D = {1..n};
+  var Keys: [D] int;
+  fillRandom(Keys, seed=42);
+
+  {
+    var A = Keys;
+    var t: Timer;
+    t.start();
+    radixSort(A);
+    t.stop();
+    report('radixSort', A, t.elapsed());
+  }
+
+  {
+    const BD = D dmapped Block(D);
+    var A: [BD] int = Keys;
+    var t: Timer;
+    t.start();
+    sort(A);
+    t.stop();
+    report('sampleSort', A, t.elapsed());
+  }
+}
+
+proc report(name, A, elapsed) {
+  if !isSorted(A) then
+    writeln(name, ' failed to sort data');
+  else
+    writeln(name, ': SUCCESS');
+
+  if printTiming {
+    writeln(name, ' time (seconds): ', elapsed);
+    writeln(name, ' rate (M keys/s): ', n / elapsed / 1e6);
+  }
+}
@@ -11,7 +11,7 @@ use Time;
 
 config const M: int = 6,                    // 2**M bytes
              correctness: bool = true,      // Disables output
-             sorts: string = 'qhims';       // Sorts to use (first letter)
+             sorts: string = 'qhimsr';      // Sorts to use (first letter)
 
 // Array properties
 config type T = int;                // Type of array
@@ -107,6 +107,18 @@ proc gatherTimings(const ref A) {
       print('selectionSort (seconds): ', t.elapsed());
     t.clear();
   }
+  if sorts.find('r')
+  {
+    var B = A;
+    t.start();
+    radixSort(B);
+    t.stop();
+    if !isSorted(B) then
+      writeln('radixSort failed to sort data');
+    else
+      print('radixSort (seconds): ', t.elapsed());
+    t.clear();
+  }
   if sorts.find('b')
   {
     var B = A;
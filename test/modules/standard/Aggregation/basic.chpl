@@ -0,0 +1,30 @@
+use Aggregation;
+
+config const n = 10000;
+
+var A: [1..n] int;
+var R: [1..n] real;
+var B: [1..n] bool;
+var hist: [0..9] int;
+
+var agg = new Aggregator();
+for i in 1..n {
+  agg.put(A[i], i);
+  agg.put(R[i], i / 2.0);
+  agg.put(B[i], i % 2 == 0);
+  agg.add(hist[i % 10], i);
+}
+agg.flush();
+writeln(+ reduce A == n * (n + 1) / 2);
+writeln(+ reduce R == n * (n + 1) / 4.0);
+writeln(+ reduce (B: int) == n / 2);
+writeln(hist);
+
+forall i in 1..n {
+  var agg = new Aggregator();
+  agg.add(hist[i % 10], -i);
+  delete agg;
+}
+writeln(hist);
+
+delete agg;
@@ -0,0 +1,33 @@
+use Aggregation, BlockDist;
+
+config const n = 100000;
+config const m = 1000;
+
+const D = {0..#n} dmapped Block({0..#n});
+const H = {0..#m} dmapped Block({0..#m});
+
+var rindex: [D] int;
+forall i in D do
+  rindex[i] = (i * 7919) % m;
+
+// histogram of rindex, using aggregated additions
+var hist: [H] int;
+coforall loc in Locales do on loc {
+  var agg = new Aggregator();
+  for i in rindex.localSubdomain() do
+    agg.add(hist[rindex[i]], 1);
+  delete agg;
+}
+writeln(+ reduce hist == n);
+writeln(&& reduce (hist == n / m));
+
+// reverse permutation of D, using aggregated puts
+var perm: [D] int;
+coforall loc in Locales do on loc {
+  var agg = new Aggregator();
+  for i in D.localSubdomain() do
+    agg.put(perm[n - 1 - i], i);
+  agg.flush();
+  delete agg;
+}
+writeln(&& reduce [i in D] (perm[i] == n - 1 - i));
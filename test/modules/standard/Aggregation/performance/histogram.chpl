@@ -0,0 +1,65 @@
+//
+// Compare three ways of building a distributed histogram from a
+// distributed array of random indices: a remote atomic add per update,
+// an on-statement per update, and per-task aggregated additions.
+//
+use BlockDist, Random, Time, Aggregation;
+
+config const n = 100000;
+config const m = 1000 * numLocales;
+config const printTiming = false;
+
+const D = {0..#n} dmapped Block({0..#n});
+const H = {0..#m} dmapped Block({0..#m});
+
+var rindex: [D] int;
+fillRandom(rindex, seed=314159265);
+rindex = mod(rindex, m);
+
+proc check(hist, name) {
+  if + reduce hist != n then
+    halt(name, ": wrong total ", + reduce hist);
+}
+
+var t: Timer;
+
+var ahist: [H] atomic int;
+t.start();
+forall r in rindex do
+  ahist[r].add(1);
+t.stop();
+const atomicTime = t.elapsed();
+check([h in ahist] h.read(), "atomic");
+
+var ohist: [H] int;
+t.clear();
+t.start();
+forall r in rindex do
+  on ohist[r] do ohist[r] += 1;
+t.stop();
+const onTime = t.elapsed();
+check(ohist, "on-stmt");
+
+var ghist: [H] int;
+t.clear();
+t.start();
+coforall loc in Locales do on loc {
+  const myInds = rindex.localSubdomain();
+  coforall tid in 0..#here.maxTaskPar {
+    var agg = new Aggregator();
+    for i in myInds by here.maxTaskPar align myInds.low + tid do
+      agg.add(ghist[rindex[i]], 1);
+    delete agg;
+  }
+}
+t.stop();
+const aggTime = t.elapsed();
+check(ghist, "aggregated");
+
+writeln("Validation: SUCCESS");
+
+if printTiming {
+  writeln("Atomic MUPS: ", n / atomicTime / 1e6);
+  writeln("On-statement MUPS: ", n / onTime / 1e6);
+  writeln("Aggregated MUPS: ", n / aggTime / 1e6);
+}
@@ -0,0 +1,13 @@
+// Without --cache-remote, the cache counters stay at zero.
+use CacheDiagnostics;
+
+var A: [1..10] int;
+
+startCacheDiagnostics();
+on Locales[numLocales-1] {
+  for i in A.domain do A[i] = A[i] + i;
+}
+stopCacheDiagnostics();
+
+writeln(getCacheDiagnostics()[0]);
+writeln(+ reduce A);
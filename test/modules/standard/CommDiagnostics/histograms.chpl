@@ -0,0 +1,72 @@
+use BlockDist;
+use CommDiagnostics;
+
+// The detailed statistics have to agree with the aggregate counts, no
+// matter how much communication the program below actually does.
+
+proc count(cd: commDiagnostics, op: commOp) {
+  select op {
+    when commOp.get do return cd.get;
+    when commOp.get_nb do return cd.get_nb;
+    when commOp.put do return cd.put;
+    when commOp.put_nb do return cd.put_nb;
+    when commOp.execute_on do return cd.execute_on;
+    when commOp.execute_on_fast do return cd.execute_on_fast;
+    otherwise do return cd.execute_on_nb;
+  }
+}
+
+proc isBlocking(op: commOp) {
+  return op == commOp.get || op == commOp.put ||
+         op == commOp.execute_on || op == commOp.execute_on_fast;
+}
+
+const D = {1..1000} dmapped Block({1..1000});
+var A: [D] int;
+var total: atomic int;
+
+resetCommDiagnostics();
+startCommDiagnostics();
+
+forall i in D do
+  A[i] = i;
+
+for i in 1..1000 by 97 do
+  A[i] += A[1001-i];
+
+sync {
+  for loc in Locales do
+    begin on loc do total.add(here.id);
+}
+
+stopCommDiagnostics();
+
+const counts = getCommDiagnostics();
+
+for op in commOp {
+  const M = getCommMatrix(op);
+
+  for loc in Locales do on loc {
+    const n = count(counts[loc.id], op);
+    const dests = getCommDestCountsHere(op);
+
+    if + reduce getCommSizeHistogramHere(op) != n then
+      writeln(op, ": size histogram doesn't match on ", loc.id);
+    if + reduce getCommLatencyHistogramHere(op) != (if isBlocking(op)
+                                                    then n else 0) then
+      writeln(op, ": latency histogram doesn't match on ", loc.id);
+    if + reduce dests != n then
+      writeln(op, ": destination counts don't match on ", loc.id);
+    if dests[loc.id] != 0 then
+      writeln(op, ": communication with itself on ", loc.id);
+    if + reduce M[loc.id, ..] != n then
+      writeln(op, ": matrix row doesn't match on ", loc.id);
+  }
+}
+
+resetCommDiagnostics();
+for op in commOp do
+  if + reduce getCommMatrix(op) != 0 then
+    writeln(op, ": not reset");
+
+writeln(total.read() == + reduce [loc in Locales] loc.id);
@@ -0,0 +1,90 @@
+// Measures the throughput of FileSystem.copyFile on one large file and of
+// FileSystem.copyTree on a tree of smaller files.
+
+use FileSystem, Time;
+
+config const fileMB = 64;          // size of the file for copyFile
+config const numDirs = 8;          // subdirectories in the copyTree source
+config const filesPerDir = 16;     // files in each subdirectory
+config const treeFileKB = 512;     // size of each file in the tree
+config const printTiming = false;
+
+const root = "copyThroughput.tmp";
+
+// Writes size bytes to name, filled with a pattern that depends on seed.
+proc makeFile(name: string, size: int, seed: int) {
+  var buf: [0..#1024*1024] uint(8);
+  var f = open(name, iomode.cw);
+  var w = f.writer(kind=ionative, locking=false);
+  var left = size;
+  while left > 0 {
+    const n = min(left, buf.size);
+    forall i in 0..#n do buf[i] = ((i + seed) % 251): uint(8);
+    w.write(buf[0..#n]);
+    left -= n;
+  }
+  w.close();
+  f.close();
+}
+
+// Checks that name holds the bytes written by makeFile(name, size, seed).
+proc checkFile(name: string, size: int, seed: int) {
+  if getFileSize(name) != size then return false;
+  var buf: [0..#1024*1024] uint(8);
+  var f = open(name, iomode.r);
+  var r = f.reader(kind=ionative, locking=false);
+  var pos = 0;
+  var ok = true;
+  while ok && pos < size {
+    const n = min(size - pos, buf.size);
+    r.read(buf[0..#n]);
+    ok = && reduce [i in 0..#n] buf[i] == ((pos + i + seed) % 251): uint(8);
+    pos += n;
+  }
+  r.close();
+  f.close();
+  return ok;
+}
+
+if exists(root) then rmTree(root);
+mkdir(root);
+
+// One large file
+const fileBytes = fileMB * 1024 * 1024;
+makeFile(root + "/big", fileBytes, 0);
+
+var t: Timer;
+t.start();
+copyFile(root + "/big", root + "/big.copy");
+t.stop();
+const fileTime = t.elapsed();
+var ok = checkFile(root + "/big.copy", fileBytes, 0);
+
+// A tree of smaller files
+const treeFileBytes = treeFileKB * 1024;
+for d in 0..#numDirs {
+  const dir = root + "/src/d" + d;
+  mkdir(dir, parents=true);
+  for i in 0..#filesPerDir do
+    makeFile(dir + "/f" + i, treeFileBytes, d * filesPerDir + i);
+}
+
+t.clear();
+t.start();
+copyTree(root + "/src", root + "/dst");
+t.stop();
+const treeTime = t.elapsed();
+for d in 0..#numDirs do
+  for i in 0..#filesPerDir do
+    ok &&= checkFile(root + "/dst/d" + d + "/f" + i, treeFileBytes,
+                     d * filesPerDir + i);
+
+rmTree(root);
+
+writeln("Validation: ", if ok then "SUCCESS" else "FAILURE");
+if printTiming {
+  const MB = 1024.0 * 1024.0;
+  writeln("copyFile MB/s: ", fileBytes / MB / fileTime);
+  writeln("copyTree MB/s: ",
+          numDirs * filesPerDir * treeFileBytes / MB / treeTime);
+}
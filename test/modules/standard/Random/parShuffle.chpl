@@ -0,0 +1,72 @@
+use Random;
+use BlockDist;
+
+config const seed: int = 17;
+config const n: int = 100000;
+
+//
+// Large arrays are shuffled in parallel; the result should be a
+// permutation that only depends on the seed, not on the number of tasks
+// or on how the array is distributed.
+//
+
+proc isPermutation(A: [] int, lo: int, hi: int) {
+  var seen: [lo..hi] bool;
+  for a in A {
+    if a < lo || a > hi || seen[a] then return false;
+    seen[a] = true;
+  }
+  return true;
+}
+
+{
+  const D = {1..n},
+        BD = D dmapped Block(boundingBox=D);
+  var A: [D] int = D,
+      B: [BD] int = BD;
+
+  shuffle(A, seed=seed);
+  shuffle(B, seed=seed);
+
+  writeln(isPermutation(A, 1, n));
+  writeln(&& reduce (A == B));
+  writeln(A[1..8]);
+}
+
+{
+  const D = {0..#n by 3};
+  var A: [D] int = D;
+
+  shuffle(A, seed=seed);
+
+  var sorted: [0..#D.size] int;
+  for (s, a) in zip(sorted, A) do s = a / 3;
+  writeln(isPermutation(sorted, 0, D.size-1));
+}
+
+{
+  const D = {1..n},
+        BD = D dmapped Block(boundingBox=D);
+  var A: [D] int,
+      B: [BD] int;
+
+  permutation(A, seed=seed);
+  permutation(B, seed=seed);
+
+  writeln(isPermutation(A, 1, n));
+  writeln(&& reduce (A == B));
+  writeln(A[1..8]);
+}
+
+{
+  var rs = makeRandomStream(seed, parSafe=false);
+  var A: [1..n] int = 1..n,
+      B: [1..n] int = 1..n;
+
+  rs.shuffle(A);
+  rs.shuffle(B);
+  writeln(|| reduce (A != B));
+  writeln(rs.getNext() == rs.getNth(2*n+1));
+
+  delete rs;
+}
@@ -0,0 +1 @@
+shuffle.chpl
\ No newline at end of file
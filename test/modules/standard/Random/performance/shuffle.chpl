@@ -0,0 +1,41 @@
+//
+// Time shuffling and permuting a large array.  The -Ntasks variants run
+// the same program with dataParTasksPerLocale limited to N; the result
+// is the same for every task count.
+//
+use Random, Time;
+
+config const n = 10000000;
+config const seed = 314159265;
+config const printTiming = false;
+
+var A: [1..n] int = 1..n;
+var t: Timer;
+
+t.start();
+shuffle(A, seed=seed);
+t.stop();
+const shuffleTime = t.elapsed();
+
+var seen: [1..n] bool;
+forall a in A do seen[a] = true;
+if !(&& reduce seen) then
+  halt("shuffle did not produce a permutation");
+
+t.clear();
+t.start();
+permutation(A, seed=seed);
+t.stop();
+const permutationTime = t.elapsed();
+
+seen = false;
+forall a in A do seen[a] = true;
+if !(&& reduce seen) then
+  halt("permutation did not produce a permutation");
+
+writeln("Validation: SUCCESS");
+
+if printTiming {
+  writeln("Shuffle time: ", shuffleTime);
+  writeln("Permutation time: ", permutationTime);
+}
@@ -0,0 +1,74 @@
+//
+// Strided bulk transfer between distributed arrays: check that each
+// assignment copies the same elements that element-wise assignment
+// would, and nothing else.
+//
+use BlockDist, CyclicDist, BlockCycDist, StencilDist;
+
+config const n = 12;
+
+const D = {1..n, 1..n};
+const BlockSpace = D dmapped Block(D),
+      CyclicSpace = D dmapped Cyclic(startIdx=D.low),
+      BlockCycSpace = D dmapped BlockCyclic(startIdx=D.low, blocksize=(2,3)),
+      StencilSpace = D dmapped Stencil(D, fluff=(1,1));
+
+var numErrors = 0;
+
+proc check(msg, ref Whole, ref A, B) {
+  const expected = for b in B do b;
+  Whole = -1;
+  A = B;
+  var i = 0;
+  for a in A {
+    if a != expected[i+1] then numErrors += 1;
+    i += 1;
+  }
+  const changed = + reduce [w in Whole] (w != -1):int;
+  if changed != A.size {
+    numErrors += 1;
+    writeln(msg, ": ", changed, " elements changed, expected ", A.size);
+  }
+}
+
+proc testPair(XSpace, YSpace, param strided = true,
+              param rankChange = strided) {
+  var X: [XSpace] int;
+  var Y: [YSpace] int;
+  forall (i,j) in YSpace do Y[i,j] = i*1000 + j;
+
+  check("whole", X, X, Y);
+  check("shifted", X, X[2..n-1, 3..n], Y[1..n-2, 1..n-2]);
+
+  var L: [1..n/2, 1..n] int;
+  check("DR = dist", L, L, Y[n/2+1..n, ..]);
+  check("dist = DR", X, X[1..n/2, ..], L);
+
+  // BlockCyclic supports neither strided slices nor rank change, and
+  // rank change of Stencil arrays is left to the Stencil tests
+  if strided {
+    check("strided rows", X, X[1..n by 2, ..], Y[2..n by 2, ..]);
+    check("reversed", X, X[1..n by 3, 2..n by 2], Y[1..n by -3, 1..n-1 by 2]);
+    check("strided DR = dist", L, L, Y[1..n by 2, ..]);
+    check("dist = strided DR", X, X[1..3, 1..n by 3], L[2..6 by 2, 1..4]);
+  }
+  if rankChange {
+    check("rank change", X, X[3, ..], Y[.., 5]);
+    check("strided rank change", X, X[2..n by 2, n-1], Y[n, 1..n by 2]);
+  }
+}
+
+// Block-Cyclic and Stencil arrays cannot be sliced with strides or rank
+// changes, so only whole and shifted transfers are tested for those.
+testPair(BlockSpace, BlockSpace);
+testPair(BlockSpace, CyclicSpace);
+testPair(BlockSpace, BlockCycSpace, strided=false);
+testPair(CyclicSpace, BlockSpace);
+testPair(CyclicSpace, CyclicSpace);
+testPair(BlockCycSpace, BlockSpace, strided=false);
+testPair(BlockCycSpace, BlockCycSpace, strided=false);
+testPair(BlockSpace, StencilSpace, strided=false);
+testPair(StencilSpace, CyclicSpace, strided=false);
+testPair(StencilSpace, StencilSpace, strided=false);
+
+writeln(if numErrors == 0 then "SUCCESS" else numErrors + " errors");
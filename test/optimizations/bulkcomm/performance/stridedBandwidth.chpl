@@ -0,0 +1,65 @@
+//
+// Measure the bandwidth of assignments between distributed arrays that
+// go through the strided bulk transfer engine: shifted and strided
+// Block-to-Block copies, a Cyclic-to-Block redistribution, and gathering
+// a strided Block slice into a local array.
+//
+use BlockDist, CyclicDist, Time;
+
+config const n = 1000;
+config const numTrials = 3;
+config const printTiming = false;
+
+const D = {1..n, 1..n};
+const BlockSpace = D dmapped Block(D),
+      CyclicSpace = D dmapped Cyclic(startIdx=D.low);
+
+var A, B: [BlockSpace] int;
+var C: [CyclicSpace] int;
+
+forall (i, j) in D with (ref B, ref C) {
+  B[i, j] = (i - 1) * n + j;
+  C[i, j] = (i - 1) * n + j;
+}
+
+proc timeIt(X, Y, expected: int): real {
+  var best = max(real);
+  var t: Timer;
+
+  for 1..numTrials {
+    X = 0;
+    t.clear();
+    t.start();
+    X = Y;
+    t.stop();
+
+    const sum = + reduce X;
+    if sum != expected then
+      halt("wrong sum ", sum, " expected ", expected);
+
+    best = min(best, t.elapsed());
+  }
+
+  return best;
+}
+
+proc sumOf(X) return + reduce X;
+
+const half = n / 2;
+var L: [1..half, 1..n] int;
+
+const shiftTime = timeIt(A[1..n-1, ..], B[2..n, ..], sumOf(B[2..n, ..])),
+      strideTime = timeIt(A[1..half, ..], B[1..n by 2, ..],
+                          sumOf(B[1..n by 2, ..])),
+      redistTime = timeIt(A, C, sumOf(C)),
+      gatherTime = timeIt(L, B[2..n by 2, ..], sumOf(B[2..n by 2, ..]));
+
+writeln("Validation: SUCCESS");
+
+if printTiming {
+  const mb = (n * n * numBytes(int)):real / (1024 * 1024);
+  writeln("Shifted Block MB/s: ", (mb - mb / n) / shiftTime);
+  writeln("Strided Block MB/s: ", (mb / 2) / strideTime);
+  writeln("Cyclic to Block MB/s: ", mb / redistTime);
+  writeln("Strided gather MB/s: ", (mb / 2) / gatherTime);
+}
@@ -0,0 +1,45 @@
+use CacheDiagnostics;
+
+config const n = 100000;
+
+var A: [0..#n] int;
+
+forall i in A.domain do
+  A[i] = i;
+
+on Locales[numLocales-1] {
+  resetCacheDiagnostics();
+  startCacheDiagnostics();
+
+  // A sequential read should mostly hit pages brought in by readahead.
+  var sum = 0;
+  for i in 0..#n do sum += A[i];
+  assert(sum == n * (n - 1) / 2);
+
+  // Writes are buffered and written back when the cache is flushed.
+  for i in 0..#n do A[i] = -i;
+
+  // An acquire fence makes the cached pages stale, so reading them
+  // again has to refetch them.
+  var s$: sync bool;
+  s$ = true;
+  s$;
+  sum = 0;
+  for i in 0..#n by 64 do sum += A[i];
+
+  stopCacheDiagnostics();
+}
+
+const cd = getCacheDiagnostics()[numLocales-1];
+
+writeln("hits > misses: ", cd.get_hits > cd.get_misses);
+writeln("readahead issued: ", cd.readahead_issued > 0);
+writeln("readahead used: ", cd.readahead_used > 0);
+writeln("dirty flushes: ", cd.dirty_flushes > 0);
+writeln("acquire invalidations: ", cd.acquire_invalidations > 0);
+writeln("locale 0 idle: ", getCacheDiagnostics()[0].get_hits == 0);
+
+resetCacheDiagnostics();
+writeln("reset: ", getCacheDiagnostics()[numLocales-1].get_hits == 0);
+
+forall i in A.domain do assert(A[i] == -i);
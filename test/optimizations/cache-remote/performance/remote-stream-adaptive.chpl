@@ -0,0 +1 @@
+remote-stream.chpl
\ No newline at end of file
@@ -0,0 +1,56 @@
+//
+// Measure the bandwidth of a single task streaming through a remote
+// array with the remote data cache enabled. The cache geometry and
+// readahead policy come from the CHPL_RT_CACHE_* environment variables,
+// so the variants of this test differ only in their .execenv files.
+//
+use Time;
+
+config const n = 1000000;
+config const numTrials = 3;
+config const printTiming = false;
+
+var A: [0..#n] int;
+
+forall i in A.domain do
+  A[i] = i;
+
+const expected = n * (n - 1) / 2;
+
+proc stream(reverse: bool): real {
+  var best = max(real);
+
+  on Locales[numLocales-1] {
+    var t: Timer;
+
+    for 1..numTrials {
+      var sum = 0;
+
+      t.clear();
+      t.start();
+      if reverse then
+        for i in 0..#n by -1 do sum += A[i];
+      else
+        for i in 0..#n do sum += A[i];
+      t.stop();
+
+      if sum != expected then
+        halt("wrong sum ", sum, " expected ", expected);
+
+      best = min(best, t.elapsed());
+    }
+  }
+
+  return best;
+}
+
+const fwdTime = stream(reverse=false);
+const revTime = stream(reverse=true);
+
+writeln("Validation: SUCCESS");
+
+if printTiming {
+  const mb = (n * numBytes(int)):real / (1024 * 1024);
+  writeln("Forward stream MB/s: ", mb / fwdTime);
+  writeln("Reverse stream MB/s: ", mb / revTime);
+}
@@ -0,0 +1,53 @@
+//
+// Measures how concurrent insertion into (and lookup in) a parSafe
+// associative domain scales with the number of inserting tasks.
+//
+use Time;
+
+config const n = 100000;
+config const maxTasks = here.maxTaskPar;
+config const printTiming = false;
+
+proc key(i: int) return i * 7919 + 3;
+
+var numTasks = 1;
+while numTasks <= maxTasks {
+  var D: domain(int);
+  const perTask = n / numTasks;
+  const total = perTask * numTasks;
+
+  var t: Timer;
+  t.start();
+  coforall tid in 0..#numTasks {
+    for i in tid*perTask..#perTask do
+      D += key(i);
+  }
+  t.stop();
+  const addTime = t.elapsed();
+
+  t.clear();
+  t.start();
+  var found: atomic int;
+  coforall tid in 0..#numTasks {
+    var myFound = 0;
+    for i in tid*perTask..#perTask do
+      if D.member(key(i)) then myFound += 1;
+    found.add(myFound);
+  }
+  t.stop();
+  const memberTime = t.elapsed();
+
+  if D.size != total || found.read() != total then
+    writeln("FAILED with ", numTasks, " tasks: ", D.size, " indices, ",
+            found.read(), " found, expected ", total);
+
+  if printTiming {
+    writeln("Tasks: ", numTasks);
+    writeln("Add time (", numTasks, " tasks): ", addTime);
+    writeln("Add rate (", numTasks, " tasks): ", total / addTime / 1e6, " M/s");
+    writeln("Member time (", numTasks, " tasks): ", memberTime);
+  }
+  numTasks *= 2;
+}
+
+writeln("SUCCESS");
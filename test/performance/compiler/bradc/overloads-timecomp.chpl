@@ -0,0 +1,39 @@
+// A compile-time benchmark for call resolution: the same few operators
+// are overloaded for many instantiations of a generic record, and called
+// for each of them, so every call sees a long list of visible functions
+// and a long list of cached instantiations.
+
+config param numTypes = 48;
+
+record R {
+  param tag: int;
+  var x: int;
+}
+
+proc +(a: R(?t), b: R(t)) return new R(t, a.x + b.x);
+proc -(a: R(?t), b: R(t)) return new R(t, a.x - b.x);
+proc *(a: R(?t), b: R(t)) return new R(t, a.x * b.x);
+proc ==(a: R(?t), b: R(t)) return a.x == b.x;
+proc <(a: R(?t), b: R(t)) return a.x < b.x;
+proc min(a: R(?t), b: R(t)) return if a < b then a else b;
+
+proc accumulate(xs: [] ?t) {
+  var acc: t;
+  for x in xs do acc = acc + x;
+  return acc;
+}
+
+var total = 0;
+
+for param i in 1..numTypes {
+  var a = new R(i, i), b = new R(i, 2);
+  var c = (a + b) * b - a;
+  if c == a || c < b then total += 1;
+  total += min(a, c).x;
+
+  var A: [1..3] R(i);
+  A[1] = a; A[2] = b; A[3] = c;
+  total += accumulate(A).x;
+}
+
+writeln(total);
@@ -0,0 +1 @@
+fib.chpl
\ No newline at end of file
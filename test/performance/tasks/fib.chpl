@@ -0,0 +1,35 @@
+//
+// Naive recursive Fibonacci, with a cobegin at every level above the
+// cutoff.  This creates a large tree of very small tasks, so it mostly
+// measures the cost of creating and scheduling tasks.
+//
+use Time;
+
+config const n = 24;
+config const cutoff = 10;
+config const printTiming = false;
+
+proc fib(n: int): int {
+  if n < 2 then
+    return n;
+
+  if n < cutoff then
+    return fib(n-1) + fib(n-2);
+
+  var a, b: int;
+  cobegin with (ref a, ref b) {
+    a = fib(n-1);
+    b = fib(n-2);
+  }
+  return a + b;
+}
+
+var t: Timer;
+t.start();
+const f = fib(n);
+t.stop();
+
+writeln("fib(", n, ") = ", f);
+
+if printTiming then
+  writeln("Elapsed time: ", t.elapsed());
@@ -0,0 +1 @@
+uts.chpl
\ No newline at end of file
@@ -0,0 +1,46 @@
+//
+// Unbalanced Tree Search, on a binomial tree: the root has 'rootKids'
+// children, and every other node has 'm' children with probability 'q'
+// and none otherwise.  With m*q close to 1 the subtrees vary enormously
+// in size, so keeping all the threads busy depends on moving tasks
+// between them.  Each node is visited by its own task.
+//
+use Time;
+
+config const rootKids = 500;
+config const m = 4;
+config const q = 0.24;
+config const seed = 42;
+config const printTiming = false;
+
+var numNodes: atomic int;
+
+// a 64-bit mixing function, used to derive each node's id from its
+// parent's
+proc mix(in x: uint): uint {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+  return x ^ (x >> 31);
+}
+
+proc numKids(id: uint): int {
+  return if (id >> 11):real / 2.0**53 < q then m else 0;
+}
+
+proc visit(id: uint, nKids: int) {
+  numNodes.add(1);
+  for i in 1..nKids {
+    const kid = mix(id + i:uint);
+    begin visit(kid, numKids(kid));
+  }
+}
+
+var t: Timer;
+t.start();
+sync visit(mix(seed:uint), rootKids);
+t.stop();
+
+writeln("nodes: ", numNodes.read());
+
+if printTiming then
+  writeln("Elapsed time: ", t.elapsed());
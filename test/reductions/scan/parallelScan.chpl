@@ -0,0 +1,52 @@
+//
+// Check parallel scans of 1-D arrays against serial prefix computations,
+// across default, strided, Block and Cyclic arrays.
+//
+use BlockDist, CyclicDist;
+
+config const n = 100003;
+
+proc check(name, A, S) {
+  var expected: [A.domain] S.eltType;
+  var sum: S.eltType;
+  for i in A.domain {
+    sum += A[i];
+    expected[i] = sum;
+  }
+  writeln(name, ": ", S.domain == A.domain && && reduce (S == expected));
+}
+
+var DR: [1..n] int;
+forall i in DR.domain do DR[i] = i % 7;
+check("default", DR, + scan DR);
+
+var ST: [0..#n by 3] real;
+forall i in ST.domain do ST[i] = (i % 5): real;
+check("strided", ST, + scan ST);
+
+const BD = {1..n} dmapped Block({1..n});
+var BA: [BD] int;
+forall i in BD do BA[i] = i % 11;
+check("block", BA, + scan BA);
+
+const CD = {1..n} dmapped Cyclic(startIdx=1);
+var CA: [CD] int;
+forall i in CD do CA[i] = i % 13;
+check("cyclic", CA, + scan CA);
+
+var B: [1..n] bool;
+forall i in B.domain do B[i] = i % 3 == 0;
+writeln("bool: ", (+ scan B)[n] == n / 3);
+
+var M: [1..n] int;
+forall i in M.domain do M[i] = (i * 7919) % n;
+var MS = max scan M;
+var running = min(int), ok = true;
+for i in M.domain {
+  running = max(running, M[i]);
+  if MS[i] != running then ok = false;
+}
+writeln("max: ", ok);
+
+var E: [1..0] int;
+writeln("empty: ", (+ scan E).size);
@@ -49,6 +49,61 @@ void check_minmax_match(void)
   }
 }
 
+void check_shared_cache(void)
+{
+  qio_regexp_options_t opts;
+  qio_regexp_t a, b, c;
+  qio_regexp_cache_stats_t stats;
+
+  qio_regexp_init_default_options(&opts);
+  qio_regexp_reset_cache_stats();
+
+  // Compiling the same pattern twice should share one compiled regexp.
+  qio_regexp_create_compile("ca+che", 6, &opts, &a);
+  qio_regexp_create_compile("ca+che", 6, &opts, &b);
+  assert(qio_regexp_ok(&a));
+  assert(a.regexp == b.regexp);
+  qio_regexp_get_cache_stats(&stats);
+  assert(stats.misses == 1);
+  assert(stats.hits == 1);
+  assert(stats.entries == 1);
+  assert(stats.capacity > 0);
+
+  // Different options mean a different compiled regexp.
+  opts.ignorecase = true;
+  qio_regexp_create_compile("ca+che", 6, &opts, &c);
+  assert(c.regexp != a.regexp);
+  qio_regexp_get_cache_stats(&stats);
+  assert(stats.misses == 2);
+  assert(stats.entries == 2);
+
+  qio_regexp_release(&a);
+  qio_regexp_release(&b);
+  qio_regexp_release(&c);
+
+  // Released patterns stay cached for later compiles.
+  opts.ignorecase = false;
+  qio_regexp_create_compile("ca+che", 6, &opts, &a);
+  qio_regexp_get_cache_stats(&stats);
+  assert(stats.hits == 2);
+  qio_regexp_release(&a);
+
+  // Filling the cache evicts entries but keeps it at its capacity.
+  for( int64_t i = 0; i < 2*stats.capacity; i++ ) {
+    char pat[32];
+    int len = snprintf(pat, sizeof(pat), "fill%d", (int) i);
+    qio_regexp_create_compile(pat, len, &opts, &a);
+    assert(qio_regexp_ok(&a));
+    qio_regexp_release(&a);
+  }
+  qio_regexp_get_cache_stats(&stats);
+  assert(stats.evictions > 0);
+  assert(stats.entries <= stats.capacity);
+
+  qio_regexp_reset_cache_stats();
+  qio_regexp_get_cache_stats(&stats);
+  assert(stats.hits == 0 && stats.misses == 0 && stats.evictions == 0);
+}
 
 int main(int argc, char** argv)
 {
@@ -58,6 +113,7 @@ int main(int argc, char** argv)
   assert(RE2::FullMatch("", "$"));
 
   check_minmax_match();
+  check_shared_cache();
 
   return 0;
 }
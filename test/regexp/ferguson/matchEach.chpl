@@ -0,0 +1,29 @@
+use Regexp;
+
+var texts = ["hello world", "say hello", "goodbye", "", "hellohello",
+             "Hello"];
+
+var re = compile("hel+o");
+
+resetRegexpCacheStats();
+
+var searched = re.searchEach(texts);
+var matched = re.matchEach(texts);
+
+// The batch versions should agree with searching each string separately.
+for (t, s, m) in zip(texts, searched, matched) {
+  writeln(t, ": ", s, " ", m);
+  const one = re.search(t);
+  const two = re.match(t);
+  assert(one.matched == s.matched && one.offset == s.offset &&
+         one.length == s.length);
+  assert(two.matched == m.matched && two.offset == m.offset &&
+         two.length == m.length);
+}
+
+// Compiling the same pattern again should hit in the cache.
+var again = compile("hel+o");
+var stats = getRegexpCacheStats();
+writeln("hits >= 1: ", stats.hits >= 1);
+writeln("entries >= 1: ", stats.entries >= 1);
+writeln("entries <= capacity: ", stats.entries <= stats.capacity);
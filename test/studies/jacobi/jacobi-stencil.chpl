@@ -0,0 +1,93 @@
+//
+// Jacobi iteration on a Stencil-distributed grid, comparing a blocking
+// fluff update with a split-phase one that overlaps the halo exchange
+// with the update of each locale's interior points.
+//
+use StencilDist, Time;
+
+config const n = 100,
+             numIters = 20,
+             printTiming = false;
+
+const Space = {1..n, 1..n},
+      Dom = Space dmapped Stencil(Space, fluff=(1,1));
+
+const north = (-1,0), south = (1,0), east = (0,1), west = (0,-1);
+
+// Boundary points keep their initial values.
+inline proc update(XNew, X, ij) {
+  const (i, j) = ij;
+  if i == 1 || i == n || j == 1 || j == n then
+    XNew[ij] = X[ij];
+  else
+    XNew[ij] = (X[ij+north] + X[ij+south] + X[ij+east] + X[ij+west]) / 4.0;
+}
+
+proc stepLocal(X, XNew) {
+  forall ij in Space do update(XNew, X, ij);
+}
+
+proc stepBlocking(X, XNew) {
+  X.updateFluff(corners=false);
+  forall ij in Dom do update(XNew, X, ij);
+}
+
+proc stepOverlapped(X, XNew) {
+  const h = X.beginUpdateFluff(corners=false);
+
+  // Points whose neighbors are all held by this locale.
+  coforall loc in Locales do on loc {
+    const inner = Dom.localSubdomain().expand(-1);
+    forall ij in inner do update(XNew, X, ij);
+  }
+
+  X.waitFluff(h);
+
+  coforall loc in Locales do on loc {
+    const myBlock = Dom.localSubdomain(),
+          inner = myBlock.expand(-1);
+    forall ij in myBlock do
+      if !inner.member(ij) then update(XNew, X, ij);
+  }
+}
+
+proc step(param kind, X, XNew) {
+  if kind == "local" then stepLocal(X, XNew);
+  else if kind == "blocking" then stepBlocking(X, XNew);
+  else stepOverlapped(X, XNew);
+}
+
+proc run(X, XNew, param kind): real {
+  X = 0.0;
+  X[n, ..] = 1.0;
+
+  var t: Timer;
+  t.start();
+  for 1..numIters/2 {
+    step(kind, X, XNew);
+    step(kind, XNew, X);
+  }
+  t.stop();
+  return t.elapsed();
+}
+
+var L, LNew: [Space] real;
+var X, XNew: [Dom] real;
+
+run(L, LNew, "local");
+
+const blockingTime = run(X, XNew, "blocking");
+var errors = + reduce [ij in Space] (X[ij] != L[ij]):int;
+
+const overlappedTime = run(X, XNew, "overlapped");
+errors += + reduce [ij in Space] (X[ij] != L[ij]):int;
+
+if errors == 0 then
+  writeln("Validation: SUCCESS");
+else
+  writeln("Validation: ", errors, " errors");
+
+if printTiming {
+  writeln("Blocking time: ", blockingTime);
+  writeln("Overlapped time: ", overlappedTime);
+}
@@ -0,0 +1,105 @@
+//
+// Compare find/rfind/count/replace against naive implementations on
+// random strings.  The small alphabet produces many partial matches, and
+// the haystack and needle lengths cover both the vectorized search for
+// short needles and the skip-table search for long ones.
+//
+use Random;
+
+config const trials = 2000;
+config const seed = 271828;
+
+proc naiveMatch(hay: string, needle: string, i: int) {
+  for j in 1..needle.length do
+    if hay[i+j-1] != needle[j] then return false;
+  return true;
+}
+
+proc naiveFind(hay: string, needle: string, r: range, fromLeft: bool): int {
+  const first = r.low, last = r.high - needle.length + 1;
+  if fromLeft {
+    for i in first..last do
+      if naiveMatch(hay, needle, i) then return i;
+  } else {
+    for i in first..last by -1 do
+      if naiveMatch(hay, needle, i) then return i;
+  }
+  return 0;
+}
+
+proc naiveCount(hay: string, needle: string, r: range) {
+  var c = 0;
+  for i in r.low..r.high - needle.length + 1 do
+    if naiveMatch(hay, needle, i) then c += 1;
+  return c;
+}
+
+proc naiveReplace(hay: string, needle: string, repl: string, count: int) {
+  var result: string, i = 1, done = 0;
+  while i <= hay.length {
+    if (count < 0 || done < count) && i + needle.length - 1 <= hay.length &&
+       naiveMatch(hay, needle, i) {
+      result += repl;
+      i += needle.length;
+      done += 1;
+    } else {
+      result += hay[i];
+      i += 1;
+    }
+  }
+  return result;
+}
+
+var rs = makeRandomStream(seed, eltType=int, parSafe=false);
+
+proc randomString(len: int) {
+  var s: string;
+  for 1..len do
+    s += if rs.getNext(0, 7) == 0 then "b" else "a";
+  return s;
+}
+
+var failures = 0;
+proc check(ok: bool, what: string, hay: string, needle: string) {
+  if !ok {
+    failures += 1;
+    if failures <= 10 then
+      writeln("mismatch in ", what, ": hay=", hay, " needle=", needle);
+  }
+}
+
+for 1..trials {
+  const hay = randomString(rs.getNext(1, 300));
+  const start = rs.getNext(1, hay.length),
+        len = rs.getNext(1, min(40, hay.length - start + 1));
+  const needle = if rs.getNext(0, 1) == 0
+    then hay[start..#len]
+    else randomString(rs.getNext(1, 40));
+  const lo = rs.getNext(1, hay.length),
+        hi = rs.getNext(lo, hay.length),
+        r = lo..hi;
+
+  check(hay.find(needle) == naiveFind(hay, needle, 1..hay.length, true),
+        "find", hay, needle);
+  check(hay.rfind(needle) == naiveFind(hay, needle, 1..hay.length, false),
+        "rfind", hay, needle);
+  check(hay.count(needle) == naiveCount(hay, needle, 1..hay.length),
+        "count", hay, needle);
+  check(hay.find(needle, r) == naiveFind(hay, needle, r, true),
+        "find in region", hay, needle);
+  check(hay.rfind(needle, r) == naiveFind(hay, needle, r, false),
+        "rfind in region", hay, needle);
+  check(hay.count(needle, r) == naiveCount(hay, needle, r),
+        "count in region", hay, needle);
+
+  const count = rs.getNext(-1, 3);
+  check(hay.replace(needle, "xyz", count) ==
+        naiveReplace(hay, needle, "xyz", count), "replace", hay, needle);
+  check(hay.replace(needle, "", count) ==
+        naiveReplace(hay, needle, "", count), "replace", hay, needle);
+}
+
+delete rs;
+
+if failures == 0 then
+  writeln("SUCCESS");
@@ -0,0 +1,62 @@
+use Time;
+
+config const timing = true;
+config const copies = 20;
+config const sourcePath = "moby.txt";
+
+// Search one large string, built from copies of the source text
+var text: string;
+{
+  var mobyFile = open(sourcePath, iomode.r);
+  var mobyReader = mobyFile.reader();
+  var chapter: string;
+  var line: string;
+  while mobyReader.readline(line) do
+    chapter += line;
+  for 1..copies do
+    text += chapter;
+}
+
+const shortNeedle = "whale";
+const longNeedle = "the whale is floating at the stern of the ship";
+const missingNeedle = "Call me Ishmael, for this line does not appear";
+
+// find
+var tFind: Timer;
+if timing then tFind.start();
+const firstMissing = text.find(missingNeedle);
+const firstLong = text.find(longNeedle);
+if timing then tFind.stop();
+
+// rfind
+var tRFind: Timer;
+if timing then tRFind.start();
+const lastMissing = text.rfind(missingNeedle);
+const lastShort = text.rfind(shortNeedle);
+if timing then tRFind.stop();
+
+// count
+var tCount: Timer;
+if timing then tCount.start();
+const numShort = text.count(shortNeedle);
+const numChar = text.count("e");
+if timing then tCount.stop();
+
+// replace
+var tReplace: Timer;
+if timing then tReplace.start();
+const replaced = text.replace(shortNeedle, "leviathan");
+if timing then tReplace.stop();
+
+if timing {
+  writeln("find: ", tFind.elapsed());
+  writeln("rfind: ", tRFind.elapsed());
+  writeln("count: ", tCount.elapsed());
+  writeln("replace: ", tReplace.elapsed());
+}
+
+if firstMissing == 0 && firstLong != 0 && lastMissing == 0 &&
+   lastShort != 0 &&
+   numShort > 0 && numChar > numShort &&
+   replaced.length == text.length + numShort * 4 then
+  writeln("SUCCESS");
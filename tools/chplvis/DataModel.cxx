@@ -31,11 +31,15 @@
 #include <time.h>
 #include <assert.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 
 // C++ Libraries
 #include <set>
+#include <algorithm>
 
 #ifndef MAXPATHLEN
 #define MAXPATHLEN 2048
@@ -106,29 +110,54 @@ int DataModel::LoadData(const char * filename, bool fromArgv)
     return 0;
   }
 
+  // The configuration data
+  int oldNumTags = numTags;
+  int nlocales;
+  int fnum;
+  int tid;
+  double seq;
+  int VerMajor, VerMinor;
+
+  // Binary data files start with a chpl_vdebug_header_t
+  chpl_vdebug_header_t hdr;
+  bool binaryData = false;
+
+  if (fread(&hdr, sizeof(hdr), 1, data) == 1
+      && memcmp(hdr.magic, CHPL_VDEBUG_MAGIC, CHPL_VDEBUG_MAGIC_LEN) == 0) {
+    if (hdr.byteOrder != CHPL_VDEBUG_BYTE_ORDER
+        || hdr.recSize != sizeof(chpl_vdebug_rec_t)) {
+      if (!fromArgv)
+        fl_message ("LoadData: %s was written on an incompatible machine.",
+                    fullfilename);
+      else
+        printf ("LoadData: %s was written on an incompatible machine.\n",
+                fullfilename);
+      fclose(data);
+      return 0;
+    }
+    binaryData = true;
+  }
+  rewind(data);
+
   // Read the config data
   char configline[100];
 
-  if (fgets(configline, 100, data) != configline) {
+  if (binaryData) {
+    VerMajor = hdr.verMajor;
+    VerMinor = hdr.verMinor;
+    nlocales = hdr.nodes;
+    fnum = hdr.nid;
+    tid = (int)hdr.tid;
+    seq = hdr.seq;
+  } else if (fgets(configline, 100, data) != configline) {
     if (!fromArgv)
       fl_message ("LoadData: Could not read file %s.", fullfilename);
     else
       printf ("LoadData: Could not read file %s.\n", fullfilename);
     fclose(data);
     return 0;
-  }
-
-  // The configuration data
-  int oldNumTags = numTags;
-  int nlocales;
-  int fnum;
-  int tid;
-  double seq;
-  int VerMajor, VerMinor;
-
-  int ssres = sscanf(configline, "ChplVdebug: ver %d.%d nodes %d nid %d tid %d seq %lf",
-                     &VerMajor, &VerMinor, &nlocales, &fnum, &tid, &seq);
-  if (ssres  != 6) {
+  } else if (sscanf(configline, "ChplVdebug: ver %d.%d nodes %d nid %d tid %d seq %lf",
+                    &VerMajor, &VerMinor, &nlocales, &fnum, &tid, &seq) != 6) {
     if (!fromArgv)
       fl_message ("\n  LoadData: incorrect data on first line of %s.",
                   fullfilename);
@@ -164,7 +193,9 @@ int DataModel::LoadData(const char * filename, bool fromArgv)
 
   for (int i = 0; i < nlocales; i++) {
     snprintf (fname, namesize+15, "%.*s%d", namesize, fullfilename, i);
-    if (!LoadFile(fname, i, seq)) {
+    int loaded = binaryData ? LoadBinaryFile(fname, i, seq)
+                            : LoadFile(fname, i, seq);
+    if (!loaded) {
       if (!fromArgv)
         fl_message ("Error processing data from %s", fname);
       else
@@ -790,6 +821,109 @@ int DataModel::LoadData(const char * filename, bool fromArgv)
 
 // Load the data in the current file
 
+// Add the newEvent to the list, group Starts, Tags, Resumes and Ends together.
+// itr is the insertion point from the previous event of the same file.
+
+void DataModel::insertEvent (Event *newEvent, evItr &itr, const char *fileToOpen)
+{
+  if (newEvent == NULL)
+    return;
+
+  if (theEvents.empty()) {
+    theEvents.push_front (newEvent);
+  } else if (itr == theEvents.end()) {
+    theEvents.insert(itr, newEvent);
+  } else {
+    if (newEvent->Ekind() <= Ev_end) {
+      // Group together
+      while (itr != theEvents.end()
+             && (*itr)->Ekind() != newEvent->Ekind())
+        itr++;
+      if (itr == theEvents.end() || (*itr)->Ekind() != newEvent->Ekind()) {
+        fprintf (stderr, "Internal error, event mismatch. file '%s'\n", fileToOpen); \
+        printf ("newEvent: "); newEvent->print();
+        if (itr != theEvents.end()) {
+           printf ("itr: "); (*itr)->print();
+        } else {
+           printf ("At end of list\n");
+        }
+      } else {
+        // More complicated ... move past proper kinds ...
+        E_tag *tp = NULL;
+        if (newEvent->Ekind() == Ev_start || newEvent->Ekind() == Ev_end) {
+          // Just find the end of the group
+          while (itr != theEvents.end() && (*itr)->Ekind() == newEvent->Ekind())
+            itr++;
+        } else {
+          // Need to move past them only if they have the same tag!
+          if (newEvent->Ekind() == Ev_tag) {
+            // Work with tags
+            tp = (E_tag *)newEvent;
+            while (itr != theEvents.end()
+                   && (*itr)->Ekind() == Ev_tag
+                   && ((E_tag *)(*itr))->tagNo() == tp->tagNo())
+              itr++;
+          } else {
+            // Work with pauses
+            E_pause *rp = (E_pause *)newEvent;
+            while (itr != theEvents.end()
+                   && (*itr)->Ekind() == Ev_pause
+                   && ((E_pause *)(*itr))->tagId() == rp->tagId())
+              itr++;
+          }
+        }
+        /*std::list<Event*>::iterator newElem = */ theEvents.insert (itr, newEvent);
+        //      if (tp != NULL && tp->nodeId() == 0) {
+        //        tagVec[tp->tagNo()-1] = newElem;
+        //      }
+      }
+    } else {
+      // Insert by time
+      while (itr != theEvents.end() &&
+             (*itr)->Ekind() > Ev_end &&
+             **itr < *newEvent)
+        itr++;
+      theEvents.insert (itr, newEvent);
+    }
+  }
+}
+
+// Remove any task or Btask records that are in the vdbTids db.
+
+void DataModel::removeVdbTasks (int findex, std::set<int> &vdbTids)
+{
+  std::list<Event *>::iterator itr;
+
+  itr = theEvents.begin();
+  while (itr != theEvents.end()) {
+    bool doErase = false;
+    Event *ev = *itr;
+    // ev->print();
+    if (ev->nodeId() == findex) {
+      switch (ev->Ekind()) {
+        case Ev_task:
+          if (vdbTids.find(((E_task *)ev)->taskId()) != vdbTids.end()) {
+            doErase = true;
+          }
+          break;
+        case Ev_begin_task:
+          if (vdbTids.find(((E_begin_task *)ev)->taskId()) != vdbTids.end()) {
+            doErase = true;
+          }
+          break;
+        default:
+          break;
+      }
+      if (doErase)
+        itr = theEvents.erase(itr);
+      else
+        itr++;
+    } else {
+      itr++;
+    }
+  }
+}
+
 int DataModel::LoadFile (const char *fileToOpen, int index, double seq)
 {
   FILE *data = fopen(fileToOpen, "r");
@@ -1162,97 +1296,10 @@ int DataModel::LoadFile (const char *fileToOpen, int index, double seq)
         /* Do nothing */ ;
     }
 
-    //  Add the newEvent to the list, group Starts, Tags, Resumes and Ends together.
-    if (newEvent) {
-      if (theEvents.empty()) {
-        theEvents.push_front (newEvent);
-      } else if (itr == theEvents.end()) {
-        theEvents.insert(itr, newEvent);
-      } else {
-        if (newEvent->Ekind() <= Ev_end) {
-          // Group together
-          while (itr != theEvents.end()
-                 && (*itr)->Ekind() != newEvent->Ekind())
-            itr++;
-          if (itr == theEvents.end() || (*itr)->Ekind() != newEvent->Ekind()) {
-            fprintf (stderr, "Internal error, event mismatch. file '%s'\n", fileToOpen); \
-            printf ("newEvent: "); newEvent->print();
-            if (itr != theEvents.end()) {
-               printf ("itr: "); (*itr)->print();
-            } else {
-               printf ("At end of list\n");
-            }
-          } else {
-            // More complicated ... move past proper kinds ...
-            E_tag *tp = NULL;
-            if (newEvent->Ekind() == Ev_start || newEvent->Ekind() == Ev_end) {
-              // Just find the end of the group
-              while (itr != theEvents.end() && (*itr)->Ekind() == newEvent->Ekind())
-                itr++;
-            } else {
-              // Need to move past them only if they have the same tag!
-              if (newEvent->Ekind() == Ev_tag) {
-                // Work with tags
-                tp = (E_tag *)newEvent;
-                while (itr != theEvents.end()
-                       && (*itr)->Ekind() == Ev_tag
-                       && ((E_tag *)(*itr))->tagNo() == tp->tagNo())
-                  itr++;
-              } else {
-                // Work with pauses
-                E_pause *rp = (E_pause *)newEvent;
-                while (itr != theEvents.end()
-                       && (*itr)->Ekind() == Ev_pause
-                       && ((E_pause *)(*itr))->tagId() == rp->tagId())
-                  itr++;
-              }
-            }
-            /*std::list<Event*>::iterator newElem = */ theEvents.insert (itr, newEvent);
-            //      if (tp != NULL && tp->nodeId() == 0) {
-            //        tagVec[tp->tagNo()-1] = newElem;
-            //      }
-          }
-        } else {
-          // Insert by time
-          while (itr != theEvents.end() &&
-                 (*itr)->Ekind() > Ev_end &&
-                 **itr < *newEvent)
-            itr++;
-          theEvents.insert (itr, newEvent);
-        }
-      }
-    }
+    insertEvent(newEvent, itr, fileToOpen);
   }
 
-  // Remove any task or Btask records that are in the vdbTids db.
-  itr = theEvents.begin();
-  while (itr != theEvents.end()) {
-    bool doErase = false;
-    Event *ev = *itr;
-    // ev->print();
-    if (ev->nodeId() == findex) {
-      switch (ev->Ekind()) {
-        case Ev_task:
-          if (vdbTids.find(((E_task *)ev)->taskId()) != vdbTids.end()) {
-            doErase = true;
-          }
-          break;
-        case Ev_begin_task:
-          if (vdbTids.find(((E_begin_task *)ev)->taskId()) != vdbTids.end()) {
-            doErase = true;
-          }
-          break;
-        default:
-          break;
-      }
-      if (doErase)
-        itr = theEvents.erase(itr);
-      else
-        itr++;
-    } else {
-      itr++;
-    }
-  }
+  removeVdbTasks(findex, vdbTids);
 
   if (nErrs) fprintf(stderr, "%d errors in data file '%s'.\n", nErrs, fileToOpen);
 
@@ -1266,6 +1313,299 @@ int DataModel::LoadFile (const char *fileToOpen, int index, double seq)
   return 1;
 }
 
+// Convert a binary event record to an Event, tracking the xxxVdebug()
+// tasks the same way LoadFile does.  Returns NULL for records that
+// should not be in the event list.
+
+Event * DataModel::binaryEvent (const chpl_vdebug_rec_t *rec,
+                                std::set<int> &vdbTids, int &nid0vdbtask)
+{
+  long sec = (long)(rec->time / 1000000);
+  long usec = (long)(rec->time % 1000000);
+  int nid = rec->nid;
+  int taskid = (int)rec->tid;
+  int nfileno;
+  int fid;
+  bool isGet;
+
+  switch (rec->kind) {
+
+    case chpl_vdebug_rec_mark:
+      if (nid == 0)
+        nid0vdbtask = taskid;
+      else
+        (void)vdbTids.insert(taskid);
+      return NULL;
+
+    case chpl_vdebug_rec_task:
+      // On tasks are not real children of VDebug tasks
+      if (!rec->u.task.isOn
+          && (vdbTids.find((int)rec->u.task.ptid) != vdbTids.end()
+              || (nid == 0 && (int)rec->u.task.ptid == nid0vdbtask))) {
+        (void)vdbTids.insert(taskid);
+        return NULL;
+      }
+      nfileno = rec->u.task.fileno;
+      if (nfileno < 0 || nfileno >= fileTblSize) nfileno = 0;
+      fid = rec->u.task.fid;
+      if (fid < 0) fid = 0;
+      return new E_task (sec, usec, nid, taskid, fid, rec->u.task.isOn,
+                         rec->u.task.lineno, nfileno);
+
+    case chpl_vdebug_rec_btask:
+      if (vdbTids.find(taskid) != vdbTids.end())
+        return NULL;
+      return new E_begin_task(sec, usec, nid, taskid);
+
+    case chpl_vdebug_rec_etask:
+      if (vdbTids.find(taskid) != vdbTids.end())
+        return NULL;
+      return new E_end_task(sec, usec, nid, taskid);
+
+    case chpl_vdebug_rec_put:
+    case chpl_vdebug_rec_get:
+    case chpl_vdebug_rec_put_nb:
+    case chpl_vdebug_rec_get_nb:
+    case chpl_vdebug_rec_put_strd:
+    case chpl_vdebug_rec_get_strd:
+      if (vdbTids.find(taskid) != vdbTids.end())
+        return NULL;
+      nfileno = rec->u.comm.fileno;
+      if (nfileno < 0 || nfileno >= fileTblSize) nfileno = 0;
+      isGet = rec->kind == chpl_vdebug_rec_get
+              || rec->kind == chpl_vdebug_rec_get_nb
+              || rec->kind == chpl_vdebug_rec_get_strd;
+      if (isGet)
+        return new E_comm (sec, usec, rec->u.comm.rnid, nid, 1,
+                           (int)rec->u.comm.size, isGet, taskid,
+                           rec->u.comm.lineno, nfileno);
+      return new E_comm (sec, usec, nid, rec->u.comm.rnid, 1,
+                         (int)rec->u.comm.size, isGet, taskid,
+                         rec->u.comm.lineno, nfileno);
+
+    case chpl_vdebug_rec_fork:
+    case chpl_vdebug_rec_fork_nb:
+    case chpl_vdebug_rec_fork_fast:
+      if (vdbTids.find(taskid) != vdbTids.end())
+        return NULL;
+      fid = rec->u.fork.fid;
+      if (fid < 0) fid = 0;
+      return new E_fork(sec, usec, nid, rec->u.fork.rnid,
+                        (int)rec->u.fork.argSize,
+                        rec->kind == chpl_vdebug_rec_fork_fast, taskid, fid);
+
+    case chpl_vdebug_rec_pause:
+      if (nid == 0)
+        nid0vdbtask = 0;
+      return new E_pause(sec, usec, nid,
+                         (long)(rec->u.times.utime / 1000000),
+                         (long)(rec->u.times.utime % 1000000),
+                         (long)(rec->u.times.stime / 1000000),
+                         (long)(rec->u.times.stime % 1000000),
+                         rec->u.times.tagno, taskid);
+
+    case chpl_vdebug_rec_tag:
+      if (rec->u.times.tagno >= numTags)
+        numTags = rec->u.times.tagno+1;
+      if (nid == 0)
+        nid0vdbtask = 0;
+      return new E_tag(sec, usec, nid,
+                       (long)(rec->u.times.utime / 1000000),
+                       (long)(rec->u.times.utime % 1000000),
+                       (long)(rec->u.times.stime / 1000000),
+                       (long)(rec->u.times.stime % 1000000),
+                       rec->u.times.tagno,
+                       (unsigned)rec->u.times.tagno < tagNames.size()
+                         ? tagNames[rec->u.times.tagno] : NULL,
+                       taskid);
+
+    case chpl_vdebug_rec_end:
+      return new E_end(sec, usec, nid,
+                       (long)(rec->u.times.utime / 1000000),
+                       (long)(rec->u.times.utime % 1000000),
+                       (long)(rec->u.times.stime / 1000000),
+                       (long)(rec->u.times.stime % 1000000),
+                       taskid);
+
+    default:
+      return NULL;
+  }
+}
+
+static bool recTimeLess (const chpl_vdebug_rec_t *a, const chpl_vdebug_rec_t *b)
+{
+  return a->time < b->time;
+}
+
+// Load a binary data file, see runtime/include/chpl-visual-debug-format.h.
+// The file is memory mapped and the records are used in place.
+
+int DataModel::LoadBinaryFile (const char *fileToOpen, int index, double seq)
+{
+  struct stat sb;
+  int fd = open(fileToOpen, O_RDONLY);
+
+  if (fd < 0) return 0;
+  if (fstat(fd, &sb) < 0 || (size_t)sb.st_size < sizeof(chpl_vdebug_header_t)) {
+    fprintf (stderr, "Error reading file %s.\n", fileToOpen);
+    close(fd);
+    return 0;
+  }
+
+  void *map = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    fprintf (stderr, "Could not map file %s: %s\n", fileToOpen, strerror(errno));
+    return 0;
+  }
+
+  // Verify the data
+
+  const chpl_vdebug_header_t *hdr = (const chpl_vdebug_header_t *)map;
+  if (memcmp(hdr->magic, CHPL_VDEBUG_MAGIC, CHPL_VDEBUG_MAGIC_LEN) != 0
+      || hdr->byteOrder != CHPL_VDEBUG_BYTE_ORDER
+      || hdr->recSize != sizeof(chpl_vdebug_rec_t)
+      || hdr->nodes != numLocales || hdr->nid != index
+      || fabs(seq-hdr->seq) > .01 || hdr->verMinor != CHPL_VDEBUG_VER_MINOR) {
+    fprintf (stderr, "Data file %s does not match other data.\n", fileToOpen);
+    munmap(map, sb.st_size);
+    return 0;
+  }
+
+  const chpl_vdebug_rec_t *recs
+    = (const chpl_vdebug_rec_t *)((const char *)map + sizeof(chpl_vdebug_header_t));
+  long nRecs = (sb.st_size - sizeof(chpl_vdebug_header_t)) / sizeof(chpl_vdebug_rec_t);
+  int findex = hdr->nid;
+  int nErrs = 0;
+
+  // Task Ids of tasks know to be part of the VisualDebug workings.
+  int nid0vdbtask = 0;
+  std::set<int> vdbTids;
+  if (findex != 0)
+    (void)vdbTids.insert((int)hdr->tid);
+
+  // Other initializations
+  numTags = 0;
+
+  // Create a start event with starting user/sys times.
+  std::list<Event *>::iterator itr = theEvents.begin();
+  Event *newEvent = new E_start((long)(hdr->time / 1000000), (long)(hdr->time % 1000000),
+                                findex,
+                                (long)(hdr->utime / 1000000), (long)(hdr->utime % 1000000),
+                                (long)(hdr->stime / 1000000), (long)(hdr->stime % 1000000));
+  if (itr == theEvents.end()) {
+    theEvents.push_front(newEvent);
+  } else {
+    // Move past existing start events
+    while ((*itr)->Ekind() == Ev_start) { itr++; }
+    theEvents.insert(itr,newEvent);
+  }
+
+  // Events are buffered per thread in the runtime, so they are only in
+  // time order between barrier (tag, pause, end) records.  Collect them
+  // and sort each group before adding them to the list.
+  std::vector<const chpl_vdebug_rec_t *> group;
+
+  for (long i = 0; i <= nRecs; i++) {
+    const chpl_vdebug_rec_t *rec = i < nRecs ? &recs[i] : NULL;
+    const char *str;
+    long strRecs;
+
+    if (rec != NULL && rec->kind >= chpl_vdebug_rec_mark
+        && rec->kind < chpl_vdebug_rec_num_kinds) {
+      group.push_back(rec);
+      continue;
+    }
+
+    if (rec == NULL || (rec->kind >= chpl_vdebug_rec_tag
+                        && rec->kind <= chpl_vdebug_rec_end)) {
+      std::stable_sort(group.begin(), group.end(), recTimeLess);
+      for (size_t j = 0; j < group.size(); j++)
+        insertEvent(binaryEvent(group[j], vdbTids, nid0vdbtask), itr, fileToOpen);
+      group.clear();
+      if (rec != NULL)
+        insertEvent(binaryEvent(rec, vdbTids, nid0vdbtask), itr, fileToOpen);
+      continue;
+    }
+
+    switch (rec->kind) {
+
+      case chpl_vdebug_rec_tables:
+        fileTblSize = rec->u.tables.fileTblSize;
+        fileTbl = new filename[fileTblSize];
+        funcTblSize = rec->u.tables.funcTblSize;
+        funcTbl = new funcInfo[funcTblSize+1];
+        funcTbl[funcTblSize].name = strdup("Unknown");
+        break;
+
+      case chpl_vdebug_rec_chpl_home:
+      case chpl_vdebug_rec_dir:
+      case chpl_vdebug_rec_fname:
+      case chpl_vdebug_rec_fidname:
+      case chpl_vdebug_rec_tname:
+        // The string follows the record
+        strRecs = CHPL_VDEBUG_STR_RECS(rec->u.str.len);
+        if (rec->u.str.len < 0 || i + strRecs >= nRecs) {
+          fprintf (stderr, "Bad string record in %s\n", fileToOpen);
+          nErrs++;
+          i = nRecs-1;
+          break;
+        }
+        str = (const char *)&recs[i+1];
+        i += strRecs;
+        switch (rec->kind) {
+          case chpl_vdebug_rec_chpl_home:
+            chpl_home = strdup(str);
+            break;
+          case chpl_vdebug_rec_dir:
+            dir = strdup(str);
+            break;
+          case chpl_vdebug_rec_fname:
+            if (rec->u.str.ix < 0 || rec->u.str.ix >= fileTblSize) {
+              nErrs++;
+            } else {
+              fileTbl[rec->u.str.ix].name = strdup(str);
+              fileTbl[rec->u.str.ix].rel2Home = strstr(str,"$CHPL_HOME/") == str;
+            }
+            break;
+          case chpl_vdebug_rec_fidname:
+            if (rec->u.str.ix < 0 || rec->u.str.ix >= funcTblSize) {
+              nErrs++;
+            } else {
+              funcTbl[rec->u.str.ix].name = strdup(str);
+              funcTbl[rec->u.str.ix].fileNo = rec->u.str.fileno;
+              funcTbl[rec->u.str.ix].lineNo = rec->u.str.lineno;
+            }
+            break;
+          case chpl_vdebug_rec_tname:
+            if (rec->u.str.ix < 0) {
+              nErrs++;
+              break;
+            }
+            while (tagNames.size() <= (unsigned)rec->u.str.ix) {
+              if (tagNames.size() == 0)
+                tagNames.resize(64);
+              else
+                tagNames.resize(2*tagNames.size());
+            }
+            tagNames[rec->u.str.ix] = strDB.getString((char *)str);
+            break;
+        }
+        break;
+
+      default:
+        nErrs++;
+    }
+  }
+
+  removeVdbTasks(findex, vdbTids);
+
+  if (nErrs) fprintf(stderr, "%d errors in data file '%s'.\n", nErrs, fileToOpen);
+
+  munmap(map, sb.st_size);
+  return 1;
+}
+
 // Get the task data by task Id and locale.
 
 taskData * DataModel::getTaskData (long locale, long taskId, long tagNo)
@@ -24,7 +24,9 @@
 #include <list>
 #include <vector>
 #include <map>
+#include <set>
 #include "StringCache.h"
+#include "chpl-visual-debug-format.h"
 
 // This class builds a list of events 
 //   Start, Stop, Pause, and Tag events are grouped together 
@@ -34,9 +36,9 @@
 // This is the class that reads the files as generated by runtime/src/chpl-visual-debug.c
 // in the Chapel runtime.
 //
-// Initially the data files are in ascii.  To turn these into binary data files,
-// both this class and runtime/src/chpl-visual-debug.c need to be modified to
-// write (chpl-visual-debug.c) and read (this class) in binary.
+// The data files are either ascii (see TextDataFormat.txt), read by LoadFile,
+// or binary (see runtime/include/chpl-visual-debug-format.h), memory mapped
+// and read by LoadBinaryFile.  The format is detected from the file for locale 0.
 
 // Support Structs used by DataModel
 
@@ -163,6 +165,11 @@ class DataModel {
   // Utility routines
   
   int LoadFile (const char *filename, int index, double seq);
+  int LoadBinaryFile (const char *filename, int index, double seq);
+  Event *binaryEvent (const chpl_vdebug_rec_t *rec, std::set<int> &vdbTids,
+                      int &nid0vdbtask);
+  void insertEvent (Event *newEvent, evItr &itr, const char *filename);
+  void removeVdbTasks (int findex, std::set<int> &vdbTids);
   
   void newList ();
   